@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+namespace rpg {
+
+// Aantal allocaties via operator new sinds de start van het programma. Alleen
+// beschikbaar in programma's die alloc_counter.cpp meelinken (rpg_bench): dat
+// bestand vervangt de globale operator new en delete.
+std::uint64_t allocationCount();
+
+} // namespace rpg
@@ -0,0 +1,194 @@
+#include "auto_player.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace rpg {
+
+namespace {
+
+struct Node {
+    std::array<std::int32_t, kAutoActions> child;
+    std::uint32_t visits = 0;
+    double total = 0.0;
+
+    Node() { child.fill(-1); }
+};
+
+struct TreeResult {
+    std::uint64_t iterations = 0;
+    std::uint64_t nodes = 0;
+    std::array<std::uint64_t, kAutoActions> visits{};
+    std::array<double, kAutoActions> total{};
+};
+
+unsigned legalActions(const BattleSnapshot& s, std::array<std::uint8_t, kAutoActions>& out) {
+    unsigned n = 0;
+    for (std::size_t a = 0; a < kAutoActions; ++a)
+        if (s.legal(AutoPlayer::actionChoice(a))) out[n++] = static_cast<std::uint8_t>(a);
+    return n;
+}
+
+// Eén boom, tot de deadline of maxIterations.
+TreeResult search(const BattleSnapshot& root, const AutoPlayerConfig& config, CounterRng rng,
+                  std::chrono::steady_clock::time_point deadline) {
+    std::vector<Node> tree(1);
+    tree.reserve(4096);
+    std::vector<std::int32_t> path;
+    std::array<std::uint8_t, kAutoActions> legal;
+    std::array<std::uint8_t, kAutoActions> untried;
+    const bool timed = config.timeBudget.count() > 0;
+
+    TreeResult r;
+    for (;;) {
+        if (config.maxIterations && r.iterations >= config.maxIterations) break;
+        if (timed && (r.iterations & 31) == 0 && r.iterations >= kAutoActions &&
+            std::chrono::steady_clock::now() >= deadline) break;
+
+        BattleSnapshot s = root;
+        path.assign(1, 0);
+        std::int32_t node = 0;
+
+        // Selectie en expansie
+        while (!s.finished()) {
+            const unsigned n = legalActions(s, legal);
+            unsigned open = 0;
+            for (unsigned i = 0; i < n; ++i)
+                if (tree[node].child[legal[i]] < 0) untried[open++] = legal[i];
+
+            if (open) {
+                const std::uint8_t a = untried[open == 1 ? 0 : rng.uniformInt(0, static_cast<int>(open) - 1)];
+                tree[node].child[a] = static_cast<std::int32_t>(tree.size());
+                tree.emplace_back();
+                node = tree[node].child[a];
+                path.push_back(node);
+                playTurn(s, AutoPlayer::actionChoice(a), rng);
+                break;
+            }
+
+            const double logN = std::log(static_cast<double>(std::max<std::uint32_t>(tree[node].visits, 1)));
+            double best = -1.0;
+            std::uint8_t pick = legal[0];
+            for (unsigned i = 0; i < n; ++i) {
+                const Node& c = tree[static_cast<std::size_t>(tree[node].child[legal[i]])];
+                const double v = c.total / c.visits + config.exploration * std::sqrt(logN / c.visits);
+                if (v > best) {
+                    best = v;
+                    pick = legal[i];
+                }
+            }
+            node = tree[node].child[pick];
+            path.push_back(node);
+            playTurn(s, AutoPlayer::actionChoice(pick), rng);
+        }
+
+        // Rollout
+        for (std::uint32_t t = 0; !s.finished() && t < config.maxRolloutTurns; ++t)
+            playTurn(s, AutoPlayer::rolloutChoice(s, config.rolloutHealThreshold), rng);
+
+        const double value = AutoPlayer::reward(s);
+        for (std::int32_t i : path) {
+            ++tree[static_cast<std::size_t>(i)].visits;
+            tree[static_cast<std::size_t>(i)].total += value;
+        }
+        ++r.iterations;
+    }
+
+    r.nodes = tree.size();
+    for (std::size_t a = 0; a < kAutoActions; ++a) {
+        const std::int32_t c = tree[0].child[a];
+        if (c < 0) continue;
+        r.visits[a] = tree[static_cast<std::size_t>(c)].visits;
+        r.total[a] = tree[static_cast<std::size_t>(c)].total;
+    }
+    return r;
+}
+
+} // namespace
+
+// ----------------------------
+// AutoPlayer
+// ----------------------------
+AutoPlayer::AutoPlayer(const AutoPlayerConfig& cfg)
+    : config(cfg) {
+    if (config.timeBudget.count() <= 0 && config.maxIterations == 0)
+        throw std::invalid_argument("AutoPlayer needs a time budget or maxIterations");
+}
+
+PlayerChoice AutoPlayer::actionChoice(std::size_t action) {
+    PlayerChoice c;
+    if (action == 1) c.action = PlayerAction::Heal;
+    else if (action >= 2) {
+        c.action = PlayerAction::UseItem;
+        c.item = static_cast<ItemKind>(action - 1);
+    }
+    return c;
+}
+
+PlayerChoice AutoPlayer::rolloutChoice(const BattleSnapshot& s, int healThreshold) {
+    PlayerChoice c;
+    if (s.hasItem(ItemKind::Sword)) c = actionChoice(1 + static_cast<std::size_t>(ItemKind::Sword));
+    else if (s.hasItem(ItemKind::Shield)) c = actionChoice(1 + static_cast<std::size_t>(ItemKind::Shield));
+    else if (s.combatants[0].health < healThreshold) {
+        c = s.hasItem(ItemKind::Potion) ? actionChoice(1 + static_cast<std::size_t>(ItemKind::Potion))
+                                        : actionChoice(1);
+    }
+    return s.legal(c) ? c : PlayerChoice();
+}
+
+double AutoPlayer::reward(const BattleSnapshot& s) {
+    const CombatantState& player = s.combatants[0];
+    if (player.health > 0 && s.finished())
+        return 0.8 + 0.2 * player.health / std::max(player.maxHealth, 1);
+
+    std::size_t defeated = 0;
+    for (std::size_t i = 1; i < s.count; ++i) defeated += s.combatants[i].health <= 0;
+    return s.count > 1 ? 0.2 * static_cast<double>(defeated) / static_cast<double>(s.count - 1) : 0.0;
+}
+
+PlayerChoice AutoPlayer::choose(const BattleSnapshot& state) {
+    const auto begin = std::chrono::steady_clock::now();
+    last = SearchStats();
+    const std::uint64_t decision = decisions++;
+
+    std::array<std::uint8_t, kAutoActions> legal;
+    const unsigned n = legalActions(state, legal);
+    if (n <= 1 || state.finished()) return n ? actionChoice(legal[0]) : PlayerChoice();
+
+    unsigned threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    const auto deadline = begin + config.timeBudget;
+
+    // Stream per (beslissing, thread): met vaste iteraties is de uitkomst reproduceerbaar.
+    std::vector<TreeResult> results(threads);
+    auto work = [&](unsigned t) {
+        results[t] = search(state, config, CounterRng(config.seed, (decision << 16) | t), deadline);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (auto& th : pool) th.join();
+
+    std::array<double, kAutoActions> total{};
+    for (auto& r : results) {
+        last.iterations += r.iterations;
+        last.nodes += r.nodes;
+        for (std::size_t a = 0; a < kAutoActions; ++a) {
+            last.visits[a] += r.visits[a];
+            total[a] += r.total[a];
+        }
+    }
+
+    std::size_t best = legal[0];
+    for (std::size_t a = 0; a < kAutoActions; ++a) {
+        if (last.visits[a]) last.meanReward[a] = total[a] / static_cast<double>(last.visits[a]);
+        if (last.visits[a] > last.visits[best] ||
+            (last.visits[a] == last.visits[best] && last.meanReward[a] > last.meanReward[best])) best = a;
+    }
+    last.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return actionChoice(best);
+}
+
+} // namespace rpg
@@ -0,0 +1,71 @@
+#pragma once
+#include "battle_snapshot.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpg {
+
+// ----------------------------
+// AutoPlayer configuratie
+// ----------------------------
+// Het zoeken stopt bij wat het eerst komt: het tijdsbudget of maxIterations
+// per thread. Met timeBudget 0 telt alleen maxIterations en is de keuze
+// deterministisch (gegeven seed en aantal threads); zonder een van beide
+// zou het zoeken nooit stoppen, dus dan gooit de constructor
+// std::invalid_argument.
+struct AutoPlayerConfig {
+    unsigned threads = 0;                        // 0 = hardware_concurrency()
+    std::chrono::milliseconds timeBudget{20};    // per beslissing
+    std::uint64_t maxIterations = 0;             // per thread, 0 = geen limiet
+    double exploration = 1.4;                    // UCB1 constante
+    std::uint64_t seed = 5489;
+    int rolloutHealThreshold = 40;               // default policy in de rollouts
+    std::uint32_t maxRolloutTurns = 1000;
+};
+
+// Acties als index: 0 = attack, 1 = heal, 1 + ItemKind = item.
+constexpr std::size_t kAutoActions = 2 + kItemKinds;
+
+struct SearchStats {
+    std::uint64_t iterations = 0;    // over alle threads
+    std::uint64_t nodes = 0;
+    double seconds = 0.0;
+    std::array<std::uint64_t, kAutoActions> visits{};
+    std::array<double, kAutoActions> meanReward{};
+};
+
+// ----------------------------
+// AutoPlayer
+// ----------------------------
+// Monte Carlo tree search over BattleSnapshot: elke thread bouwt een eigen
+// open-loop UCT boom vanaf dezelfde snapshot (root parallel, dus geen locks
+// in de zoeklus) en de root visits worden aan het eind opgeteld. Een knoop
+// is een reeks acties; de toevalsuitkomsten worden per iteratie opnieuw
+// getrokken, zodat de boom de verwachting over de rolls meet.
+//
+// Reward: 0.8 + 0.2 * HP fractie bij winst, anders 0.2 * fractie verslagen
+// monsters. Rollouts gebruiken rolloutChoice().
+class AutoPlayer : public PlayerPolicy {
+public:
+    explicit AutoPlayer(const AutoPlayerConfig& config = AutoPlayerConfig());   // zie AutoPlayerConfig
+
+    PlayerChoice choose(const BattleSnapshot& state) override;
+
+    inline const SearchStats& lastSearch() const { return last; }
+
+    // Snelle vaste policy: items met blijvend effect meteen, potion of heal
+    // onder healThreshold, anders aanvallen.
+    static PlayerChoice rolloutChoice(const BattleSnapshot& state, int healThreshold);
+
+    static PlayerChoice actionChoice(std::size_t action);
+    static double reward(const BattleSnapshot& state);
+
+private:
+    AutoPlayerConfig config;
+    SearchStats last;
+    std::uint64_t decisions = 0;
+};
+
+} // namespace rpg
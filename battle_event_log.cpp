@@ -0,0 +1,338 @@
+#include "battle_event_log.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace rpg {
+
+namespace {
+
+constexpr char kEventMagic[4] = {'R', 'P', 'G', 'B'};
+constexpr std::uint32_t kEventVersion = 1;
+
+struct NameEntryHeader {
+    std::uint16_t length;
+    std::uint8_t level;
+    std::uint8_t reserved;
+    std::int32_t maxHealth;
+};
+static_assert(sizeof(NameEntryHeader) == 8, "NameEntryHeader must stay 8 bytes");
+
+// Zoals catalog.cpp: from_chars weigert ook waarden buiten int.
+bool parseInt(const std::string& s, std::size_t begin, std::size_t end, int& out) {
+    if (begin >= end) return false;
+    auto r = std::from_chars(s.data() + begin, s.data() + end, out);
+    return r.ec == std::errc() && r.ptr == s.data() + end;
+}
+
+bool endsWith(const std::string& s, std::size_t end, const char* suffix) {
+    std::size_t n = std::strlen(suffix);
+    return end >= n && s.compare(end - n, n, suffix) == 0;
+}
+
+} // namespace
+
+// ----------------------------
+// NameTable
+// ----------------------------
+std::uint16_t NameTable::intern(const std::string& name, unsigned char level, int maxHealth) {
+    auto it = index.find(name);
+    if (it != index.end()) {
+        CombatantInfo& info = entries[it->second];
+        if (info.level == 0) info.level = level;
+        if (info.maxHealth == 0) info.maxHealth = maxHealth;
+        return it->second;
+    }
+    if (entries.size() > 0xFFFF) throw std::length_error("Too many combatants for the event log");
+    std::uint16_t id = static_cast<std::uint16_t>(entries.size());
+    entries.push_back({name, level, maxHealth});
+    index.emplace(name, id);
+    return id;
+}
+
+// ----------------------------
+// Tekst formaat
+// ----------------------------
+void formatAttack(std::string& out, std::string_view actor, std::string_view target,
+                  int damage, std::uint8_t flags) {
+    out += actor;
+    out += " attacks ";
+    out += target;
+    out += " for ";
+    out += std::to_string(damage);
+    out += " damage";
+    if (flags & EventCritical) out += " (CRITICAL HIT!)";
+    if (flags & EventShield) out += " [Blocked by shield]";
+    out += "\n";
+}
+
+void formatStatus(std::string& out, std::string_view name, int level, int health, int maxHealth) {
+    out += "[LOG] ";
+    out += name;
+    out += " (Lv ";
+    out += std::to_string(level);
+    out += ") HP: ";
+    out += std::to_string(health);
+    out += "/";
+    out += std::to_string(maxHealth);
+    out += "\n";
+}
+
+void formatEvent(std::string& out, const EventRecord& e, const NameTable& names) {
+    switch (static_cast<EventKind>(e.kind)) {
+    case EventKind::Attack:
+        formatAttack(out, names[e.actor].name, names[e.target].name, e.damage, e.flags);
+        break;
+    case EventKind::Status: {
+        const CombatantInfo& c = names[e.actor];
+        formatStatus(out, c.name, c.level, e.hpAfter, c.maxHealth);
+        break;
+    }
+    case EventKind::BattleEnd:
+        break;
+    }
+}
+
+bool parseEventLine(const std::string& line, NameTable& names, EventRecord& out) {
+    std::size_t end = line.size();
+    if (end > 0 && line[end - 1] == '\r') --end;
+    out = EventRecord{};
+
+    // [LOG] <naam> (Lv <level>) HP: <hp>/<max>
+    if (line.compare(0, 6, "[LOG] ") == 0) {
+        std::size_t lv = line.rfind(" (Lv ", end);
+        std::size_t hp = line.find(") HP: ", lv == std::string::npos ? end : lv);
+        std::size_t slash = line.find('/', hp == std::string::npos ? end : hp);
+        int level, health, maxHealth;
+        if (lv == std::string::npos || hp == std::string::npos || slash == std::string::npos
+            || !parseInt(line, lv + 5, hp, level) || !parseInt(line, hp + 6, slash, health)
+            || !parseInt(line, slash + 1, end, maxHealth))
+            return false;
+        out.kind = static_cast<std::uint8_t>(EventKind::Status);
+        out.actor = names.intern(line.substr(6, lv - 6), static_cast<unsigned char>(level), maxHealth);
+        out.target = out.actor;
+        out.hpAfter = health;
+        return true;
+    }
+
+    // <actor> attacks <target> for <n> damage[ (CRITICAL HIT!)][ [Blocked by shield]]
+    std::size_t attacks = line.find(" attacks ");
+    if (attacks == std::string::npos) return false;
+    if (endsWith(line, end, " [Blocked by shield]")) {
+        out.flags |= EventShield;
+        end -= std::strlen(" [Blocked by shield]");
+    }
+    if (endsWith(line, end, " (CRITICAL HIT!)")) {
+        out.flags |= EventCritical;
+        end -= std::strlen(" (CRITICAL HIT!)");
+    }
+    if (!endsWith(line, end, " damage")) return false;
+    end -= std::strlen(" damage");
+    std::size_t forPos = line.rfind(" for ", end);
+    int damage;
+    if (forPos == std::string::npos || forPos < attacks || !parseInt(line, forPos + 5, end, damage))
+        return false;
+
+    out.kind = static_cast<std::uint8_t>(EventKind::Attack);
+    out.actor = names.intern(line.substr(0, attacks));
+    out.target = names.intern(line.substr(attacks + 9, forPos - attacks - 9));
+    out.damage = damage;
+    out.hpAfter = -1; // staat niet in de aanvalsregel; volgt uit de [LOG] regel
+    return true;
+}
+
+// ----------------------------
+// EventLogWriter
+// ----------------------------
+EventLogWriter::~EventLogWriter() {
+    close();
+}
+
+bool EventLogWriter::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (file) {
+        // Bestaand bestand: header en name table inlezen, daarna hervatten.
+        EventLogHeader header;
+        if (file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            && std::memcmp(header.magic, kEventMagic, 4) == 0 && header.version == kEventVersion) {
+            recordCount = header.recordCount;
+            file.seekg(static_cast<std::streamoff>(header.nameTableOffset));
+            for (std::uint32_t i = 0; i < header.nameCount; ++i) {
+                NameEntryHeader entry;
+                file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+                std::string name(entry.length, '\0');
+                file.read(&name[0], entry.length);
+                if (!file) break;
+                table.intern(name, entry.level, entry.maxHealth);
+            }
+            if (recordCount > 0) {
+                EventRecord last;
+                file.seekg(static_cast<std::streamoff>(sizeof(EventLogHeader) + (recordCount - 1) * sizeof(EventRecord)));
+                if (file.read(reinterpret_cast<char*>(&last), sizeof(last)))
+                    battle = last.battle + (last.kind == static_cast<std::uint8_t>(EventKind::BattleEnd) ? 1 : 0);
+            }
+            file.clear();
+            return true;
+        }
+        // Een ander bestand (bijvoorbeeld de tekst log) niet overschrijven.
+        file.clear();
+        file.seekg(0, std::ios::end);
+        const bool empty = file.tellg() == std::streampos(0);
+        file.close();
+        if (!empty) return false;
+    }
+
+    file.clear();
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    recordCount = 0;
+    battle = 0;
+    flush();
+    return true;
+}
+
+void EventLogWriter::append(EventRecord e) {
+    e.battle = battle;
+    pending.push_back(e);
+}
+
+void EventLogWriter::endBattle() {
+    EventRecord e{};
+    e.kind = static_cast<std::uint8_t>(EventKind::BattleEnd);
+    append(e);
+    ++battle;
+}
+
+void EventLogWriter::flush() {
+    if (!file.is_open()) return;
+
+    const std::uint64_t recordsEnd = sizeof(EventLogHeader) + recordCount * sizeof(EventRecord);
+    file.seekp(static_cast<std::streamoff>(recordsEnd));
+    if (!pending.empty())
+        file.write(reinterpret_cast<const char*>(pending.data()),
+                   static_cast<std::streamsize>(pending.size() * sizeof(EventRecord)));
+    recordCount += pending.size();
+    pending.clear();
+
+    const std::uint64_t tableOffset = sizeof(EventLogHeader) + recordCount * sizeof(EventRecord);
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const CombatantInfo& c = table[static_cast<std::uint16_t>(i)];
+        NameEntryHeader entry{static_cast<std::uint16_t>(c.name.size()), c.level, 0,
+                              static_cast<std::int32_t>(c.maxHealth)};
+        file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        file.write(c.name.data(), static_cast<std::streamsize>(c.name.size()));
+    }
+
+    EventLogHeader header{};
+    std::memcpy(header.magic, kEventMagic, 4);
+    header.version = kEventVersion;
+    header.recordCount = recordCount;
+    header.nameTableOffset = tableOffset;
+    header.nameCount = static_cast<std::uint32_t>(table.size());
+    header.recordSize = sizeof(EventRecord);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.flush();
+}
+
+void EventLogWriter::close() {
+    if (!file.is_open()) return;
+    flush();
+    file.close();
+}
+
+// ----------------------------
+// EventLogView
+// ----------------------------
+EventLogView::EventLogView(const std::string& path)
+    : mapped(path), head(nullptr), records(nullptr), source(path) {
+    if (mapped.size() < sizeof(EventLogHeader))
+        throw std::runtime_error(path + " is not a binary battle log");
+    head = reinterpret_cast<const EventLogHeader*>(mapped.data());
+    if (std::memcmp(head->magic, kEventMagic, 4) != 0 || head->version != kEventVersion
+        || head->recordSize != sizeof(EventRecord))
+        throw std::runtime_error(path + " is not a binary battle log");
+    if (head->nameTableOffset > mapped.size() || head->nameTableOffset < sizeof(EventLogHeader)
+        || head->recordCount > (head->nameTableOffset - sizeof(EventLogHeader)) / sizeof(EventRecord))
+        throw std::runtime_error(path + " is truncated");
+
+    records = reinterpret_cast<const EventRecord*>(mapped.data() + sizeof(EventLogHeader));
+
+    const unsigned char* p = mapped.data() + head->nameTableOffset;
+    const unsigned char* limit = mapped.data() + mapped.size();
+    for (std::uint32_t i = 0; i < head->nameCount; ++i) {
+        NameEntryHeader entry;
+        if (p + sizeof(entry) > limit) throw std::runtime_error(path + " is truncated");
+        std::memcpy(&entry, p, sizeof(entry));
+        p += sizeof(entry);
+        if (p + entry.length > limit) throw std::runtime_error(path + " is truncated");
+        table.intern(std::string(reinterpret_cast<const char*>(p), entry.length), entry.level, entry.maxHealth);
+        p += entry.length;
+    }
+}
+
+void EventLogView::corrupt(const EventRecord& e) const {
+    const std::size_t index = static_cast<std::size_t>(&e - records);
+    if (e.kind < static_cast<std::uint8_t>(EventKind::Attack) || e.kind > static_cast<std::uint8_t>(EventKind::BattleEnd))
+        throw std::runtime_error(source + " is corrupt: unknown event kind in record " + std::to_string(index));
+    throw std::runtime_error(source + " is corrupt: unknown combatant id in record " + std::to_string(index));
+}
+
+// ----------------------------
+// Conversie tekst <-> binair
+// ----------------------------
+void writeTextLog(const EventLogView& log, std::ostream& out) {
+    std::string batch;
+    for (const EventRecord& e : log) {
+        log.check(e);
+        formatEvent(batch, e, log.names());
+        if (batch.size() >= (1u << 20)) {
+            out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            batch.clear();
+        }
+    }
+    out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+}
+
+// De HP na een aanval komt uit de [LOG] regel van het doelwit die erop volgt.
+std::uint64_t convertTextLog(std::istream& in, EventLogWriter& writer) {
+    std::vector<EventRecord> pending;   // records van de huidige aanval
+    std::uint16_t pairA = 0xFFFF, pairB = 0xFFFF;
+    bool started = false;
+
+    auto release = [&] {
+        for (auto& r : pending) writer.append(r);
+        pending.clear();
+    };
+
+    std::string line;
+    EventRecord e;
+    std::uint64_t skipped = 0;
+    while (std::getline(in, line)) {
+        if (!parseEventLine(line, writer.names(), e)) {
+            ++skipped;
+            continue;
+        }
+        if (e.kind == static_cast<std::uint8_t>(EventKind::Attack)) {
+            release();
+            std::uint16_t a = std::min(e.actor, e.target), b = std::max(e.actor, e.target);
+            if (started && (a != pairA || b != pairB)) writer.endBattle();
+            pairA = a;
+            pairB = b;
+            started = true;
+            pending.push_back(e);
+        } else {
+            if (!pending.empty() && pending.front().hpAfter < 0 && pending.front().target == e.actor)
+                pending.front().hpAfter = e.hpAfter;
+            pending.push_back(e);
+        }
+        if (writer.pendingBytes() >= (1u << 20)) writer.flush();
+    }
+    release();
+    if (started) writer.endBattle();
+    return skipped;
+}
+
+} // namespace rpg
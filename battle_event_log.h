@@ -0,0 +1,173 @@
+#pragma once
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Binair event formaat
+// ----------------------------
+// Layout (native little-endian):
+//   EventLogHeader                     32 bytes
+//   EventRecord[recordCount]           20 bytes per record
+//   name table op nameTableOffset      per combatant: u16 lengte, u8 level,
+//                                      u8 reserved, i32 maxHealth, naam
+// De header en name table worden bij elke flush herschreven, zodat het
+// bestand na elke flush geldig is. Combatants worden, net als in de tekst
+// log, op naam geïdentificeerd.
+enum class EventKind : std::uint8_t {
+    Attack = 1,     // actor valt target aan; hpAfter = HP van target
+    Status = 2,     // [LOG] regel van actor; hpAfter = HP van actor
+    BattleEnd = 3
+};
+
+enum EventFlag : std::uint8_t {
+    EventCritical = 1 << 0,
+    EventShield = 1 << 1
+};
+
+struct EventLogHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t recordCount;
+    std::uint64_t nameTableOffset;
+    std::uint32_t nameCount;
+    std::uint32_t recordSize;
+};
+static_assert(sizeof(EventLogHeader) == 32, "EventLogHeader must stay 32 bytes");
+
+struct EventRecord {
+    std::uint32_t battle;
+    std::uint16_t actor;
+    std::uint16_t target;
+    std::int32_t damage;
+    std::int32_t hpAfter;
+    std::uint8_t kind;
+    std::uint8_t flags;
+    std::uint16_t reserved;
+};
+static_assert(sizeof(EventRecord) == 20, "EventRecord must stay 20 bytes");
+
+struct CombatantInfo {
+    std::string name;
+    unsigned char level = 0;
+    int maxHealth = 0;
+};
+
+// ----------------------------
+// NameTable: naam -> id
+// ----------------------------
+class NameTable {
+private:
+    std::vector<CombatantInfo> entries;
+    std::unordered_map<std::string, std::uint16_t> index;
+
+public:
+    // level/maxHealth 0 = onbekend; wordt ingevuld zodra ze bekend zijn.
+    std::uint16_t intern(const std::string& name, unsigned char level = 0, int maxHealth = 0);
+
+    inline const CombatantInfo& operator[](std::uint16_t id) const { return entries[id]; }
+    inline std::size_t size() const { return entries.size(); }
+};
+
+// ----------------------------
+// Tekst formaat (battle_log.txt)
+// ----------------------------
+void formatAttack(std::string& out, std::string_view actor, std::string_view target,
+                  int damage, std::uint8_t flags);
+void formatStatus(std::string& out, std::string_view name, int level, int health, int maxHealth);
+void formatEvent(std::string& out, const EventRecord& e, const NameTable& names);
+
+// Parseert een regel uit battle_log.txt; false als het geen event is.
+bool parseEventLine(const std::string& line, NameTable& names, EventRecord& out);
+
+// ----------------------------
+// EventLogWriter
+// ----------------------------
+class EventLogWriter {
+private:
+    std::fstream file;
+    NameTable table;
+    std::vector<EventRecord> pending;
+    std::uint64_t recordCount = 0;
+    std::uint32_t battle = 0;
+
+public:
+    ~EventLogWriter();
+
+    // Hervat een bestaand bestand of maakt een nieuw; false als dat niet lukt
+    // of als er al een ander (niet leeg) bestand staat.
+    bool open(const std::string& path);
+    bool isOpen() const { return file.is_open(); }
+
+    inline NameTable& names() { return table; }
+    inline std::uint32_t currentBattle() const { return battle; }
+
+    void append(EventRecord e);
+    void endBattle();
+    inline std::size_t pendingBytes() const { return pending.size() * sizeof(EventRecord); }
+    void flush();
+    void close();
+};
+
+// ----------------------------
+// EventLogView: gemapt bestand
+// ----------------------------
+// De constructor controleert header en name table en gooit
+// std::runtime_error als er iets niet klopt. De records zelf worden niet
+// gelezen: lezers roepen check() aan in hun eigen pass, zodat een query één
+// keer over de gemapte records loopt.
+class EventLogView {
+private:
+    MappedFile mapped;
+    const EventLogHeader* head;
+    const EventRecord* records;
+    NameTable table;
+    std::string source;
+
+    [[noreturn]] void corrupt(const EventRecord& e) const;
+
+public:
+    explicit EventLogView(const std::string& path);
+
+    // Attack en Status records moeten naar een bestaande naam verwijzen.
+    inline bool valid(const EventRecord& e) const {
+        switch (static_cast<EventKind>(e.kind)) {
+        case EventKind::Attack:
+        case EventKind::Status:
+            return e.actor < table.size() && e.target < table.size();
+        case EventKind::BattleEnd:
+            return true;
+        }
+        return false;
+    }
+    inline void check(const EventRecord& e) const {   // std::runtime_error als !valid(e)
+        if (!valid(e)) corrupt(e);
+    }
+
+    inline const EventLogHeader& header() const { return *head; }
+    inline const NameTable& names() const { return table; }
+    inline std::size_t size() const { return static_cast<std::size_t>(head->recordCount); }
+    inline const EventRecord* begin() const { return records; }
+    inline const EventRecord* end() const { return records + size(); }
+};
+
+// ----------------------------
+// Conversie tekst <-> binair
+// ----------------------------
+// writeTextLog schrijft dezelfde regels als de tekst sink. convertTextLog
+// leest battle_log.txt regels en geeft het aantal regels terug dat geen
+// event is. In de tekst log staan geen battle grenzen: een nieuwe battle
+// begint zodra een aanval tussen een ander paar combatants plaatsvindt.
+void writeTextLog(const EventLogView& log, std::ostream& out);
+std::uint64_t convertTextLog(std::istream& in, EventLogWriter& writer);
+
+} // namespace rpg
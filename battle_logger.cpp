@@ -0,0 +1,423 @@
+#include "battle_logger.h"
+#include "battle_event_log.h"
+#include "instrumentation.h"
+#include "ring_buffer.h"
+#include "rpg_classes.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace rpg {
+
+namespace {
+
+// ----------------------------
+// LogEntry: een slot in de ring buffer
+// ----------------------------
+// Bevat een ruwe tekstregel of een gestructureerd event. Namen (actor en
+// daarna target) staan inline in text; bij lange namen gaat de tekst via
+// een losse string zodat het formaat byte-voor-byte gelijk blijft.
+enum class EntryKind : std::uint8_t { Line, Attack, Status, BattleEnd };
+
+struct LogEntry {
+    static constexpr std::size_t kInline = 200;
+
+    EntryKind kind = EntryKind::Line;
+    std::uint8_t flags = 0;
+    unsigned char actorLevel = 0;
+    unsigned char targetLevel = 0;
+    std::int32_t damage = 0;
+    std::int32_t hpAfter = 0;
+    std::int32_t actorMaxHealth = 0;
+    std::int32_t targetMaxHealth = 0;
+    std::uint32_t length = 0;
+    std::uint32_t actorLength = 0;
+    char text[kInline] = {};
+    std::unique_ptr<std::string> overflow;
+
+    void setText(const std::string& first, const std::string& second = std::string()) {
+        length = static_cast<std::uint32_t>(first.size() + second.size());
+        actorLength = static_cast<std::uint32_t>(first.size());
+        if (length <= kInline) {
+            std::memcpy(text, first.data(), first.size());
+            std::memcpy(text + first.size(), second.data(), second.size());
+            overflow.reset();
+        } else {
+            overflow = std::make_unique<std::string>(first + second);
+        }
+    }
+
+    const char* chars() const { return overflow ? overflow->data() : text; }
+    std::string_view actor() const { return std::string_view(chars(), actorLength); }
+    std::string_view target() const { return std::string_view(chars() + actorLength, length - actorLength); }
+};
+
+// ----------------------------
+// Sinks: tekst of binair
+// ----------------------------
+std::string logPath(const LoggerConfig& config) {
+    if (!config.path.empty()) return config.path;
+    return config.format == LogFormat::Binary ? "battle_log.bin" : "battle_log.txt";
+}
+
+class LogSink {
+public:
+    virtual ~LogSink() {}
+    virtual bool append(const LogEntry& entry) = 0;   // false: record weggegooid
+    virtual std::size_t pendingBytes() const = 0;
+    virtual void write() = 0;   // batch naar het bestand
+    virtual void sync() = 0;    // batch + OS flush
+};
+
+class TextSink : public LogSink {
+public:
+    TextSink(const LoggerConfig& config) {
+        batch.reserve(config.flushBytes + LogEntry::kInline);
+        try {
+            const std::string path = logPath(config);
+            file.open(path, std::ios::app);
+            if (!file) throw std::ios_base::failure("Cannot open " + path);
+        } catch (const std::ios_base::failure& e) {
+            std::cerr << "File I/O error: " << e.what() << "\n";
+        }
+    }
+
+    bool append(const LogEntry& e) override {
+        switch (e.kind) {
+        case EntryKind::Line:
+            batch.append(e.chars(), e.length);
+            break;
+        case EntryKind::Attack:
+            formatAttack(batch, e.actor(), e.target(), e.damage, e.flags);
+            break;
+        case EntryKind::Status:
+            formatStatus(batch, e.actor(), e.actorLevel, e.hpAfter, e.actorMaxHealth);
+            break;
+        case EntryKind::BattleEnd:
+            break;
+        }
+        return true;
+    }
+
+    std::size_t pendingBytes() const override { return batch.size(); }
+
+    void write() override {
+        RPG_TIME_SCOPE(LogWrite);
+        writeBatch();
+    }
+
+    void sync() override {
+        RPG_TIME_SCOPE(LogWrite);
+        writeBatch();
+        if (file) file.flush();
+    }
+
+private:
+    void writeBatch() {
+        RPG_COUNT(BytesLogged, batch.size());
+        if (file) file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        batch.clear();
+    }
+
+    std::ofstream file;
+    std::string batch;
+};
+
+class BinarySink : public LogSink {
+public:
+    BinarySink(const LoggerConfig& config) {
+        try {
+            const std::string path = logPath(config);
+            if (!events.open(path)) throw std::ios_base::failure("Cannot open " + path);
+        } catch (const std::ios_base::failure& e) {
+            std::cerr << "File I/O error: " << e.what() << "\n";
+        }
+    }
+
+    // Een vol name table (65536 namen) mag de writer thread niet stoppen:
+    // het record wordt weggegooid en geteld in droppedLines().
+    bool append(const LogEntry& e) override {
+        EventRecord r{};
+        try {
+            switch (e.kind) {
+            case EntryKind::Line:
+                return true; // vrije tekst heeft geen binaire vorm
+            case EntryKind::Attack:
+                r.kind = static_cast<std::uint8_t>(EventKind::Attack);
+                r.actor = events.names().intern(std::string(e.actor()), e.actorLevel, e.actorMaxHealth);
+                r.target = events.names().intern(std::string(e.target()), e.targetLevel, e.targetMaxHealth);
+                r.damage = e.damage;
+                r.hpAfter = e.hpAfter;
+                r.flags = e.flags;
+                break;
+            case EntryKind::Status:
+                r.kind = static_cast<std::uint8_t>(EventKind::Status);
+                r.actor = events.names().intern(std::string(e.actor()), e.actorLevel, e.actorMaxHealth);
+                r.target = r.actor;
+                r.hpAfter = e.hpAfter;
+                break;
+            case EntryKind::BattleEnd:
+                events.endBattle();
+                return true;
+            }
+        } catch (const std::length_error& error) {
+            if (!nameTableFull) std::cerr << "Battle log error: " << error.what() << ", dropping events\n";
+            nameTableFull = true;
+            return false;
+        }
+        events.append(r);
+        return true;
+    }
+
+    std::size_t pendingBytes() const override { return events.pendingBytes(); }
+    void write() override {
+        RPG_TIME_SCOPE(LogWrite);
+        RPG_COUNT(BytesLogged, events.pendingBytes());
+        events.flush();
+    }
+    void sync() override { write(); }
+
+private:
+    EventLogWriter events;
+    bool nameTableFull = false;
+};
+
+// ----------------------------
+// LogWriter: achtergrond thread met het open logbestand
+// ----------------------------
+class LogWriter {
+public:
+    explicit LogWriter(const LoggerConfig& cfg)
+        : config(cfg), ring(cfg.capacity) {
+        thread = std::thread(&LogWriter::run, this);
+    }
+
+    ~LogWriter() {
+        stopRequested.store(true);
+        wake();
+        thread.join();
+    }
+
+    void push(LogEntry&& entry) {
+        while (!ring.tryPush(std::move(entry))) {
+            if (config.backpressure == Backpressure::DropNewest) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wake();
+            std::this_thread::yield();
+        }
+        // Alleen wekken als de buffer vol begint te lopen; anders pakt de
+        // writer de regels op bij het volgende interval.
+        if (writerIdle.load() && ring.approxSize() >= ring.capacity() / 2) wake();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const std::uint64_t ticket = ++flushRequested;
+        wakeup.notify_one();
+        flushDone.wait(lock, [&] { return flushCompleted >= ticket; });
+    }
+
+    std::size_t droppedLines() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void wake() {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeup.notify_one();
+    }
+
+    void drain(LogSink& sink) {
+        LogEntry entry;
+        while (ring.tryPop(entry)) {
+            if (!sink.append(entry)) dropped.fetch_add(1, std::memory_order_relaxed);
+            if (sink.pendingBytes() >= config.flushBytes) {
+                sink.write();
+                lastFlush = Clock::now();
+            }
+        }
+    }
+
+    void run() {
+        std::unique_ptr<LogSink> sink;
+        if (config.format == LogFormat::Binary) sink = std::make_unique<BinarySink>(config);
+        else sink = std::make_unique<TextSink>(config);
+        lastFlush = Clock::now();
+
+        for (;;) {
+            std::uint64_t requested;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                requested = flushRequested;
+            }
+            const bool stopping = stopRequested.load();
+
+            drain(*sink);
+
+            const bool forced = requested != flushCompleted || stopping;
+            if (forced) {
+                sink->sync();
+                lastFlush = Clock::now();
+            } else if (sink->pendingBytes() > 0 && Clock::now() - lastFlush >= config.flushInterval) {
+                sink->write();
+                lastFlush = Clock::now();
+            }
+
+            if (requested != flushCompleted) {
+                std::lock_guard<std::mutex> lock(mutex);
+                flushCompleted = requested;
+                flushDone.notify_all();
+            }
+            if (stopping) break;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            writerIdle.store(true);
+            wakeup.wait_for(lock, config.flushInterval, [&] {
+                return stopRequested.load() || flushRequested != flushCompleted
+                       || ring.approxSize() >= ring.capacity() / 2;
+            });
+            writerIdle.store(false);
+        }
+    }
+
+    const LoggerConfig config;
+    RingBuffer<LogEntry> ring;
+    Clock::time_point lastFlush;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable flushDone;
+    std::uint64_t flushRequested = 0;   // beschermd door mutex
+    std::uint64_t flushCompleted = 0;   // beschermd door mutex
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> writerIdle{false};
+    std::atomic<std::size_t> dropped{0};
+
+    std::thread thread;
+};
+
+// ----------------------------
+// Globale logger state
+// ----------------------------
+struct LoggerState {
+    std::mutex mutex;
+    LoggerConfig config;
+    std::unique_ptr<LogWriter> owner;
+    std::atomic<LogWriter*> writer{nullptr};
+    std::atomic<bool> enabled{true};
+    std::atomic<bool> flushOnBattleEnd{false};   // kopie van config, leesbaar zonder lock
+
+    ~LoggerState() {
+        writer.store(nullptr);
+        owner.reset(); // laatste batch wegschrijven en thread joinen
+    }
+};
+
+LoggerState& state() {
+    static LoggerState s;
+    return s;
+}
+
+LogWriter& writer() {
+    LoggerState& s = state();
+    if (LogWriter* w = s.writer.load(std::memory_order_acquire)) return *w;
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.owner) {
+        s.owner = std::make_unique<LogWriter>(s.config);
+        s.writer.store(s.owner.get(), std::memory_order_release);
+    }
+    return *s.owner;
+}
+
+bool loggingEnabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+// ----------------------------
+// BattleLogger
+// ----------------------------
+void BattleLogger::configure(const LoggerConfig& config) {
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.writer.store(nullptr);
+    s.owner.reset();
+    s.config = config;
+    s.enabled.store(config.enabled, std::memory_order_release);
+    s.flushOnBattleEnd.store(config.flushOnBattleEnd, std::memory_order_relaxed);
+}
+
+void BattleLogger::logAttack(const Character& attacker, const Character& target, const AttackResult& hit) {
+    RPG_TIME_SCOPE(LogAttack);
+    if (!loggingEnabled()) return;
+    LogEntry entry;
+    entry.kind = EntryKind::Attack;
+    entry.flags = static_cast<std::uint8_t>((hit.critical ? EventCritical : 0) | (hit.blocked ? EventShield : 0));
+    entry.damage = hit.damage;
+    entry.hpAfter = target.health;
+    entry.actorLevel = attacker.level;
+    entry.actorMaxHealth = attacker.maxHealth;
+    entry.targetLevel = target.level;
+    entry.targetMaxHealth = target.maxHealth;
+    entry.setText(attacker.name, target.name);
+    writer().push(std::move(entry));
+}
+
+void BattleLogger::logStatus(const Character& c) {
+    RPG_TIME_SCOPE(LogStatus);
+    if (!loggingEnabled()) return;
+    LogEntry entry;
+    entry.kind = EntryKind::Status;
+    entry.hpAfter = c.health;
+    entry.actorLevel = c.level;
+    entry.actorMaxHealth = c.maxHealth;
+    entry.setText(c.name);
+    writer().push(std::move(entry));
+}
+
+void BattleLogger::logLine(const std::string& line) {
+    if (!loggingEnabled()) return;
+    LogEntry entry;
+    entry.setText(line);
+    writer().push(std::move(entry));
+}
+
+void BattleLogger::battleEnded() {
+    if (!loggingEnabled()) return;
+    LogEntry entry;
+    entry.kind = EntryKind::BattleEnd;
+    writer().push(std::move(entry));
+
+    if (state().flushOnBattleEnd.load(std::memory_order_relaxed)) flush();
+}
+
+void BattleLogger::flush() {
+    if (!loggingEnabled()) return;
+    writer().flush();
+}
+
+void BattleLogger::shutdown() {
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.writer.store(nullptr);
+    s.owner.reset();
+}
+
+std::size_t BattleLogger::droppedLines() {
+    LoggerState& s = state();
+    LogWriter* w = s.writer.load(std::memory_order_acquire);
+    return w ? w->droppedLines() : 0;
+}
+
+} // namespace rpg
@@ -0,0 +1,55 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace rpg {
+
+class Character;
+struct AttackResult;
+
+// ----------------------------
+// Logger configuratie
+// ----------------------------
+enum class Backpressure {
+    Block,      // producer wacht tot de writer plaats heeft gemaakt
+    DropNewest  // regel wordt weggegooid en geteld in droppedLines()
+};
+
+enum class LogFormat {
+    Text,   // battle_log.txt regels
+    Binary  // vaste EventRecords, zie battle_event_log.h
+};
+
+struct LoggerConfig {
+    bool enabled = true;                              // false: alle log calls doen niets
+    std::string path;                                 // leeg: battle_log.txt, binair battle_log.bin
+    LogFormat format = LogFormat::Text;
+    std::size_t capacity = 4096;                      // slots in de ring buffer
+    std::size_t flushBytes = 64 * 1024;               // flush zodra de batch zo groot is
+    std::chrono::milliseconds flushInterval{200};     // flush minstens zo vaak
+    bool flushOnBattleEnd = false;                    // true: battleEnded() wacht op een flush
+    Backpressure backpressure = Backpressure::Block;
+};
+
+// ----------------------------
+// Friend class BattleLogger
+// ----------------------------
+// Combat code schrijft events in een lock-free ring buffer; een achtergrond
+// thread houdt het logbestand open, formatteert (tekst of binair) en schrijft
+// in batches weg. configure() en shutdown() mogen niet tegelijk met het
+// loggen lopen. droppedLines() telt regels die niet geschreven zijn: bij
+// DropNewest, of in binair formaat als het name table vol is.
+class BattleLogger {
+public:
+    static void configure(const LoggerConfig& config);
+    static void logAttack(const Character& attacker, const Character& target, const AttackResult& hit);
+    static void logStatus(const Character& c);
+    static void logLine(const std::string& line);   // alleen in tekst formaat
+    static void battleEnded();
+    static void flush();
+    static void shutdown();
+    static std::size_t droppedLines();
+};
+
+} // namespace rpg
@@ -0,0 +1,265 @@
+#include "battle_simulator.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace rpg {
+
+// ----------------------------
+// Histogram
+// ----------------------------
+void Histogram::add(std::size_t value) {
+    if (value >= buckets.size()) buckets.resize(value + 1, 0);
+    ++buckets[value];
+    ++count;
+    sum += value;
+}
+
+void Histogram::merge(const Histogram& other) {
+    if (other.buckets.size() > buckets.size()) buckets.resize(other.buckets.size(), 0);
+    for (std::size_t i = 0; i < other.buckets.size(); ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+}
+
+double Histogram::mean() const {
+    return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
+
+std::size_t Histogram::percentile(double p) const {
+    if (count == 0) return 0;
+    const double target = p * static_cast<double>(count);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (static_cast<double>(seen) >= target) return i;
+    }
+    return buckets.size() - 1;
+}
+
+// ----------------------------
+// SimulationStats
+// ----------------------------
+double SimulationStats::winRate() const {
+    return battles ? static_cast<double>(wins) / static_cast<double>(battles) : 0.0;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    battles += other.battles;
+    wins += other.wins;
+    turns.merge(other.turns);
+    heals.merge(other.heals);
+    hpRemaining.merge(other.hpRemaining);
+    if (monsters.size() < other.monsters.size()) monsters.resize(other.monsters.size());
+    for (std::size_t i = 0; i < other.monsters.size(); ++i) {
+        if (monsters[i].name.empty()) monsters[i].name = other.monsters[i].name;
+        monsters[i].fights += other.monsters[i].fights;
+        monsters[i].kills += other.monsters[i].kills;
+        monsters[i].turnsToKill.merge(other.monsters[i].turnsToKill);
+    }
+    if (other.longestTurns > longestTurns) {
+        longestTurns = other.longestTurns;
+        longestBattle = other.longestBattle;
+    }
+    if (other.lowestHp >= 0 && (lowestHp < 0 || other.lowestHp < lowestHp)) {
+        lowestHp = other.lowestHp;
+        lowestHpBattle = other.lowestHpBattle;
+    }
+}
+
+void printReport(std::ostream& os, const SimulationStats& stats) {
+    os << "Battles simulated: " << stats.battles << "\n"
+       << "Win rate: " << std::fixed << std::setprecision(4) << stats.winRate() * 100.0 << "%\n"
+       << "Turns per campaign: mean " << stats.turns.mean()
+       << ", p50 " << stats.turns.percentile(0.5)
+       << ", p99 " << stats.turns.percentile(0.99) << "\n"
+       << "Heals per campaign: mean " << stats.heals.mean() << "\n"
+       << "HP remaining: mean " << stats.hpRemaining.mean()
+       << ", p10 " << stats.hpRemaining.percentile(0.1)
+       << ", p50 " << stats.hpRemaining.percentile(0.5) << "\n";
+    for (auto& m : stats.monsters) {
+        os << "- " << m.name << ": fought " << m.fights << ", killed " << m.kills
+           << ", turns to kill mean " << m.turnsToKill.mean()
+           << " (p50 " << m.turnsToKill.percentile(0.5)
+           << ", p99 " << m.turnsToKill.percentile(0.99) << ")\n";
+    }
+    os << "Longest campaign: battle #" << stats.longestBattle
+       << " (" << stats.longestTurns << " turns)\n"
+       << "Lowest HP left: battle #" << stats.lowestHpBattle
+       << " (" << stats.lowestHp << " HP)\n";
+}
+
+// ----------------------------
+// Campagne zonder Game
+// ----------------------------
+// Zelfde regels als Game::start; decide(hero) vervangt de vaste heal check.
+namespace {
+
+template<bool Verbose, typename Policy>
+CampaignResult playCampaign(Roster& roster, Rng& rng, int healAmount,
+                            Policy&& decide, SimulationStats* stats) {
+    CampaignResult result;
+    roster.reset();
+    Character& hero = roster[0];
+    OutputSink& sink = hero.out();
+    const bool show = Verbose && sink.enabled();
+    auto status = [&](const Character& c) {
+        if (show) sink.emit({GameEventKind::Status, &c, nullptr, c.getHealth()});
+        BattleLogger::logStatus(c);
+    };
+
+    for (std::size_t i = 1; i < roster.size() && hero.isAlive(); ++i) {
+        Character& m = roster[i];
+        std::uint32_t fightTurns = 0;
+        if (show) sink.emit({GameEventKind::BattleStart, nullptr, &m});
+
+        while (hero.isAlive() && m.isAlive()) {
+            if (Verbose) {
+                roster.attack(0, m);
+                status(m);
+            } else {
+                hero.strike(m, 1, rng);
+            }
+            ++fightTurns;
+            if (!m.isAlive()) break;
+
+            if (Verbose) {
+                roster.attack(i, hero);
+                status(hero);
+            } else {
+                m.strike(hero, 1, rng);
+            }
+
+            if (decide(hero) == Decision::Heal) {
+                bool healed = Verbose ? roster.heal(0, healAmount) : roster.applyHeal(0, healAmount);
+                if (Verbose) status(hero);
+                if (healed) ++result.heals;
+            }
+            if (show) sink.emit({GameEventKind::TurnEnd});
+        }
+        if (Verbose) {
+            sink.flush();
+            BattleLogger::battleEnded();
+        }
+
+        if (stats) {
+            MonsterStats& ms = stats->monsters[i - 1];
+            ++ms.fights;
+            if (!m.isAlive()) {
+                ++ms.kills;
+                ms.turnsToKill.add(fightTurns);
+            }
+        }
+        result.turns += fightTurns;
+    }
+
+    result.won = hero.isAlive();
+    result.hpRemaining = hero.getHealth();
+    return result;
+}
+
+} // namespace
+
+// ----------------------------
+// BattleSimulator
+// ----------------------------
+BattleSimulator::BattleSimulator(const Game& game)
+    : roster(game.getRoster()) {}
+
+void BattleSimulator::runWorker(const SimulationConfig& config, std::uint64_t begin,
+                                std::uint64_t end, SimulationStats& out) const {
+    // Eigen kopie van de roster en lokale statistieken per worker (geen
+    // false sharing); per campagne alleen restore().
+    Roster members(roster);
+    SimulationStats local;
+
+    local.monsters.resize(members.size() - 1);
+    for (std::size_t i = 1; i < members.size(); ++i) local.monsters[i - 1].name = members[i].getName();
+
+    auto policy = [&](const Character& p) {
+        return p.getHealth() < config.healThreshold ? Decision::Heal : Decision::Continue;
+    };
+
+    for (std::uint64_t b = begin; b < end; ++b) {
+        CounterRng rng = CounterRng::forBattle(config.seed, b);
+        CampaignResult r = playCampaign<false>(members, rng, config.healAmount, policy, &local);
+
+        ++local.battles;
+        if (r.won) ++local.wins;
+        local.turns.add(r.turns);
+        local.heals.add(r.heals);
+        local.hpRemaining.add(static_cast<std::size_t>(r.hpRemaining));
+        if (r.turns > local.longestTurns) {
+            local.longestTurns = r.turns;
+            local.longestBattle = b;
+        }
+        if (local.lowestHp < 0 || r.hpRemaining < local.lowestHp) {
+            local.lowestHp = r.hpRemaining;
+            local.lowestHpBattle = b;
+        }
+    }
+    out = std::move(local);
+}
+
+SimulationStats BattleSimulator::run(const SimulationConfig& config) const {
+    unsigned threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (config.battles < threads) threads = static_cast<unsigned>(std::max<std::uint64_t>(config.battles, 1));
+
+    std::vector<SimulationStats> partial(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    const std::uint64_t share = config.battles / threads;
+    const std::uint64_t rest = config.battles % threads;
+    std::uint64_t begin = 0;
+    for (unsigned w = 0; w < threads; ++w) {
+        std::uint64_t end = begin + share + (w < rest ? 1 : 0);
+        workers.emplace_back(&BattleSimulator::runWorker, this, std::cref(config), begin,
+                             end, std::ref(partial[w]));
+        begin = end;
+    }
+    for (auto& t : workers) t.join();
+
+    SimulationStats total;
+    for (auto& p : partial) total.merge(p);
+    return total;
+}
+
+BattleReplay BattleSimulator::record(const SimulationConfig& config, std::uint64_t battleIndex) const {
+    BattleReplay replay;
+    replay.seed = config.seed;
+    replay.battleIndex = battleIndex;
+    replay.healAmount = config.healAmount;
+
+    Roster members(roster);
+    CounterRng rng = CounterRng::forBattle(config.seed, battleIndex);
+    auto policy = [&](const Character& p) {
+        Decision d = p.getHealth() < config.healThreshold ? Decision::Heal : Decision::Continue;
+        replay.decisions.push_back(d);
+        return d;
+    };
+    replay.expected = playCampaign<false>(members, rng, config.healAmount, policy, nullptr);
+    return replay;
+}
+
+CampaignResult BattleSimulator::replay(const BattleReplay& replay, bool verbose) const {
+    Roster members(roster);
+    CounterRng rng = CounterRng::forBattle(replay.seed, replay.battleIndex);
+
+    std::size_t next = 0;
+    auto policy = [&](const Character&) {
+        if (next >= replay.decisions.size())
+            throw std::runtime_error("Replay decision stream is exhausted");
+        return replay.decisions[next++];
+    };
+
+    if (!verbose) return playCampaign<false>(members, rng, replay.healAmount, policy, nullptr);
+
+    members.setRng(&rng);
+    return playCampaign<true>(members, rng, replay.healAmount, policy, nullptr);
+}
+
+} // namespace rpg
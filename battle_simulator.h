@@ -0,0 +1,98 @@
+#pragma once
+#include "rpg_classes.h"
+#include "replay.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Simulatie instellingen
+// ----------------------------
+struct SimulationConfig {
+    std::uint64_t battles = 1000000;
+    unsigned threads = 0;          // 0 = alle cores
+    std::uint64_t seed = 5489;
+    int healThreshold = 40;        // zelfde beleid als Game::start
+    int healAmount = 20;
+};
+
+// ----------------------------
+// Histogram met een bucket per waarde
+// ----------------------------
+class Histogram {
+private:
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+
+public:
+    void add(std::size_t value);
+    void merge(const Histogram& other);
+
+    inline std::uint64_t total() const { return count; }
+    inline const std::vector<std::uint64_t>& getBuckets() const { return buckets; }
+    double mean() const;
+    std::size_t percentile(double p) const;
+};
+
+struct MonsterStats {
+    std::string name;
+    std::uint64_t fights = 0;
+    std::uint64_t kills = 0;
+    Histogram turnsToKill;
+};
+
+// ----------------------------
+// Geaggregeerde resultaten
+// ----------------------------
+struct SimulationStats {
+    std::uint64_t battles = 0;
+    std::uint64_t wins = 0;
+    Histogram turns;         // aanvallen van de speler per campagne
+    Histogram heals;         // heals per campagne
+    Histogram hpRemaining;   // HP van de speler na de laatste fight
+    std::vector<MonsterStats> monsters;
+
+    // Uitschieters, terug te spelen via BattleSimulator::record().
+    std::uint64_t longestBattle = 0;
+    std::uint32_t longestTurns = 0;
+    std::uint64_t lowestHpBattle = 0;
+    int lowestHp = -1;
+
+    double winRate() const;
+    void merge(const SimulationStats& other);
+};
+
+void printReport(std::ostream& os, const SimulationStats& stats);
+
+// ----------------------------
+// BattleSimulator
+// ----------------------------
+// Speelt Player-vs-roster campagnes zonder console output. Battle i gebruikt
+// CounterRng::forBattle(seed, i), dus het resultaat hangt niet af van het
+// aantal threads en elke battle kan los opnieuw gespeeld worden. Elke worker
+// houdt eigen statistieken bij; die worden pas aan het einde samengevoegd.
+class BattleSimulator {
+private:
+    Roster roster;   // kopie van de Game roster; [0] = speler
+
+    void runWorker(const SimulationConfig& config, std::uint64_t begin,
+                   std::uint64_t end, SimulationStats& out) const;
+
+public:
+    explicit BattleSimulator(const Game& game);
+
+    SimulationStats run(const SimulationConfig& config) const;
+
+    // Speelt battle battleIndex uit een run met config en legt de beslissingen vast.
+    BattleReplay record(const SimulationConfig& config, std::uint64_t battleIndex) const;
+
+    // Speelt een replay opnieuw af; verbose geeft dezelfde output als Game::start.
+    CampaignResult replay(const BattleReplay& replay, bool verbose = false) const;
+};
+
+} // namespace rpg
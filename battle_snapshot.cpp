@@ -0,0 +1,138 @@
+#include "battle_snapshot.h"
+#include "damage_pipeline.h"
+#include <algorithm>
+
+namespace rpg {
+
+namespace {
+
+// Zelfde volgorde van trekkingen als Character::strike.
+void strike(CombatantState& attacker, CombatantState& target, Rng& rng) {
+    if (attacker.flags & CombatantState::Stunned) {
+        attacker.flags &= static_cast<std::uint8_t>(~CombatantState::Stunned);
+        return;
+    }
+    const bool critical = rng.uniformInt(1, 100) <= attacker.criticalChance;
+    if (critical) attacker.flags |= CombatantState::CriticalActive;
+    else attacker.flags &= static_cast<std::uint8_t>(~CombatantState::CriticalActive);
+
+    DamageContext ctx;
+    ctx.raw = attacker.attackPower + attacker.attackBonus;
+    ctx.variation = rng.uniformInt(8, 12);
+    ctx.critical = critical;
+    ctx.shielded = (target.flags & CombatantState::Shield) != 0;
+    target.health = std::max(target.health - StandardDamage::apply(ctx), 0);
+}
+
+bool removeItem(BattleSnapshot& s, ItemKind kind) {
+    for (std::uint8_t i = 0; i < s.itemCount; ++i) {
+        if (s.items[i] != kind) continue;
+        for (std::uint8_t j = i; j + 1 < s.itemCount; ++j) s.items[j] = s.items[j + 1];
+        --s.itemCount;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ----------------------------
+// BattleSnapshot
+// ----------------------------
+bool BattleSnapshot::hasItem(ItemKind kind) const {
+    for (std::uint8_t i = 0; i < itemCount; ++i)
+        if (items[i] == kind) return true;
+    return false;
+}
+
+bool BattleSnapshot::legal(const PlayerChoice& choice) const {
+    switch (choice.action) {
+    case PlayerAction::Attack: return true;
+    case PlayerAction::Heal: return combatants[0].health < combatants[0].maxHealth;
+    case PlayerAction::UseItem: return choice.item != ItemKind::None && hasItem(choice.item);
+    }
+    return false;
+}
+
+void applyItem(CombatantState& c, ItemKind kind) {
+    switch (kind) {
+    case ItemKind::Sword:
+        c.attackBonus += kSwordBonus;
+        break;
+    case ItemKind::Shield:
+        c.flags |= CombatantState::Shield;
+        break;
+    case ItemKind::Potion:
+        c.health = std::min(c.health + kPotionHeal, c.maxHealth);
+        break;
+    default:
+        break;
+    }
+}
+
+// ----------------------------
+// Regels
+// ----------------------------
+void advance(BattleSnapshot& s, Rng& rng) {
+    CombatantState& player = s.combatants[0];
+    for (;;) {
+        switch (s.stage) {
+        case GameStage::Setup:
+            s.current = 1;
+            s.stage = s.count == 0 ? GameStage::Finished : GameStage::BattleStart;
+            break;
+        case GameStage::BattleStart:
+            if (s.current >= s.count) s.stage = GameStage::Summary;
+            else s.stage = player.health > 0 && s.combatants[s.current].health > 0
+                           ? GameStage::PlayerAttack : GameStage::BattleEnd;
+            break;
+        case GameStage::PlayerAttack:
+            return;
+        case GameStage::MonsterAttack:
+            strike(s.combatants[s.current], player, rng);
+            s.stage = GameStage::HealCheck;
+            break;
+        case GameStage::HealCheck:
+            ++s.turns;
+            s.stage = player.health > 0 && s.combatants[s.current].health > 0
+                      ? GameStage::PlayerAttack : GameStage::BattleEnd;
+            break;
+        case GameStage::BattleEnd:
+            if (player.health > 0) {
+                ++s.current;
+                s.stage = GameStage::BattleStart;
+            } else {
+                s.stage = GameStage::Summary;
+            }
+            break;
+        case GameStage::Summary:
+            s.stage = GameStage::Finished;
+            break;
+        case GameStage::Finished:
+            return;
+        }
+    }
+}
+
+void playTurn(BattleSnapshot& s, const PlayerChoice& choice, Rng& rng) {
+    advance(s, rng);
+    if (s.finished()) return;
+
+    CombatantState& player = s.combatants[0];
+    CombatantState& monster = s.combatants[s.current];
+    switch (choice.action) {
+    case PlayerAction::Attack:
+        strike(player, monster, rng);
+        break;
+    case PlayerAction::Heal:
+        player.health = std::min(player.health + BattleSnapshot::kHealAmount, player.maxHealth);
+        break;
+    case PlayerAction::UseItem:
+        if (removeItem(s, choice.item)) applyItem(player, choice.item);
+        break;
+    }
+    s.stage = monster.health > 0 ? GameStage::MonsterAttack : GameStage::BattleEnd;
+    advance(s, rng);
+}
+
+} // namespace rpg
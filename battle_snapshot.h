@@ -0,0 +1,110 @@
+#pragma once
+#include "items.h"
+#include "rng.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace rpg {
+
+// ----------------------------
+// Stages van een campagne
+// ----------------------------
+enum class GameStage : std::uint8_t {
+    Setup,          // monsters tonen
+    BattleStart,    // volgende monster aankondigen
+    PlayerAttack,   // actie van de speler (met een PlayerPolicy: attack, heal of item)
+    MonsterAttack,
+    HealCheck,      // heal onder 40 HP (zonder PlayerPolicy), einde van de beurt
+    BattleEnd,
+    Summary,        // inventory en winnaar
+    Finished
+};
+
+// ----------------------------
+// Keuzes van de speler
+// ----------------------------
+enum class PlayerAction : std::uint8_t {
+    Attack,
+    Heal,
+    UseItem
+};
+
+struct PlayerChoice {
+    PlayerAction action = PlayerAction::Attack;
+    ItemKind item = ItemKind::None;
+};
+
+// ----------------------------
+// BattleSnapshot
+// ----------------------------
+// De hele speelbare toestand van een Game in een vast blok zonder pointers:
+// kopiëren is een memcpy van ~200 bytes. Namen staan er niet in; een
+// snapshot hoort bij de roster waar hij van gemaakt is.
+//
+// Een roster met meer dan kMaxCombatants combatants komt er als venster in:
+// de speler plus de monsters vanaf het huidige, combatants[i] is dan
+// roster[offset + i]. Voorbij het venster eindigt de snapshot alsof de
+// campagne klaar is; Game::restore() gaat daar verder met het volgende
+// monster.
+struct CombatantState {
+    enum : std::uint8_t { Stunned = 1, Shield = 2, CriticalActive = 4, Poisoned = 8 };
+
+    std::int32_t health;
+    std::int32_t maxHealth;
+    std::int32_t attackPower;
+    std::int32_t attackBonus;
+    std::uint8_t level;
+    std::uint8_t criticalChance;
+    std::uint8_t flags;
+    std::uint8_t reserved;
+};
+
+struct BattleSnapshot {
+    static constexpr std::size_t kMaxCombatants = 8;
+    static constexpr std::size_t kMaxItems = Inventory::kCapacity;   // alle items passen
+    static constexpr int kHealAmount = 20;   // Player::heal standaard
+
+    std::array<CombatantState, kMaxCombatants> combatants;   // [0] = speler
+    std::array<ItemKind, kMaxItems> items;                   // bruikbare items van de speler
+    std::uint32_t turns;
+    std::uint32_t offset;       // roster index van combatants[1] min 1
+    std::uint32_t rosterSize;
+    std::uint8_t count;
+    std::uint8_t current;    // monster index, zie GameStatus::monster
+    GameStage stage;
+    std::uint8_t itemCount;
+
+    inline bool finished() const { return stage == GameStage::Finished; }
+    inline bool playerWon() const { return finished() && combatants[0].health > 0; }
+    bool hasItem(ItemKind kind) const;
+    bool legal(const PlayerChoice& choice) const;
+};
+
+static_assert(std::is_trivially_copyable<BattleSnapshot>::value, "BattleSnapshot must stay trivially copyable");
+
+// ----------------------------
+// Regels op een snapshot
+// ----------------------------
+// Dezelfde regels en random trekkingen als Game met een PlayerPolicy, maar
+// zonder output en logging. advance() speelt door tot de speler moet kiezen
+// (stage PlayerAttack) of de campagne klaar is; playTurn() voert de keuze
+// uit en doet daarna advance().
+void advance(BattleSnapshot& s, Rng& rng);
+void playTurn(BattleSnapshot& s, const PlayerChoice& choice, Rng& rng);
+
+// Effect van een item op een combatant (zonder het uit de inventory te halen).
+void applyItem(CombatantState& c, ItemKind kind);
+
+// ----------------------------
+// PlayerPolicy
+// ----------------------------
+// Kiest de actie van de speler in Game::stepAction() (zie Game::setPolicy).
+class PlayerPolicy {
+public:
+    virtual ~PlayerPolicy() {}
+    virtual PlayerChoice choose(const BattleSnapshot& state) = 0;
+};
+
+} // namespace rpg
@@ -0,0 +1,342 @@
+#include "catalog.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace rpg {
+
+namespace {
+
+constexpr char kCatalogMagic[4] = {'R', 'P', 'G', 'C'};
+constexpr std::uint32_t kCatalogVersion = 1;
+constexpr std::size_t kMinBuckets = 8;
+
+std::uint32_t hashName(std::string_view s) {
+    std::uint32_t h = 2166136261u;   // FNV-1a
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Slot met deze naam of het eerste lege slot; buckets als de tabel vol is.
+template<typename NameAt>
+std::size_t findSlot(const std::uint32_t* slots, std::size_t buckets, std::string_view name, NameAt nameAt) {
+    std::size_t i = hashName(name) & (buckets - 1);
+    for (std::size_t n = 0; n < buckets; ++n, i = (i + 1) & (buckets - 1))
+        if (slots[i] == 0 || nameAt(slots[i] - 1) == name) return i;
+    return buckets;
+}
+
+// Houdt de tabel hooguit half vol.
+template<typename NameAt>
+void reserveSlots(std::vector<std::uint32_t>& slots, std::size_t count, NameAt nameAt) {
+    if (count * 2 <= slots.size()) return;
+    std::vector<std::uint32_t> grown(slots.size() * 2, 0);
+    for (std::uint32_t v : slots) {
+        if (v == 0) continue;
+        grown[findSlot(grown.data(), grown.size(), nameAt(v - 1), nameAt)] = v;
+    }
+    slots.swap(grown);
+}
+
+std::size_t align8(std::size_t n) {
+    return (n + 7) & ~std::size_t(7);
+}
+
+bool isPowerOfTwo(std::uint64_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+int parseNumber(std::string_view s, int lo, int hi, const char* what) {
+    int value = 0;
+    auto r = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (r.ec != std::errc() || r.ptr != s.data() + s.size() || value < lo || value > hi)
+        throw std::runtime_error(std::string("invalid ") + what + " '" + std::string(s) + "'");
+    return value;
+}
+
+} // namespace
+
+// ----------------------------
+// Catalog
+// ----------------------------
+Catalog::Catalog()
+    : Catalog(CatalogBuilder().build()) {}
+
+Catalog::Catalog(std::vector<unsigned char> bytes)
+    : image(std::move(bytes)) {
+    attach(image.data(), image.size(), "catalog");
+}
+
+Catalog::Catalog(std::unique_ptr<MappedFile> file, const std::string& source)
+    : mapped(std::move(file)) {
+    attach(mapped->data(), mapped->size(), source);
+}
+
+void Catalog::attach(const unsigned char* bytes, std::size_t size, const std::string& source) {
+    base = bytes;
+    length = size;
+    if (size < sizeof(CatalogHeader)) throw std::runtime_error(source + " is not a catalog");
+    head = reinterpret_cast<const CatalogHeader*>(bytes);
+    if (std::memcmp(head->magic, kCatalogMagic, 4) != 0) throw std::runtime_error(source + " is not a catalog");
+    if (head->version != kCatalogVersion) throw std::runtime_error(source + " has an unsupported catalog version");
+
+    auto section = [&](std::uint64_t offset, std::uint64_t count, std::size_t element) {
+        if (offset % 8 != 0 || offset > size || count > (size - offset) / element)
+            throw std::runtime_error(source + " is truncated");
+        return bytes + offset;
+    };
+    monsters = reinterpret_cast<const CombatantRecord*>(section(head->monsterOffset, head->monsterCount, sizeof(CombatantRecord)));
+    items = reinterpret_cast<const ItemRecord*>(section(head->itemOffset, head->itemCount, sizeof(ItemRecord)));
+    campaignList = reinterpret_cast<const std::uint32_t*>(section(head->campaignOffset, head->campaignCount, 4));
+    inventoryList = reinterpret_cast<const std::uint32_t*>(section(head->inventoryOffset, head->inventoryCount, 4));
+    monsterSlots = reinterpret_cast<const std::uint32_t*>(section(head->monsterSlotOffset, head->monsterBuckets, 4));
+    itemSlots = reinterpret_cast<const std::uint32_t*>(section(head->itemSlotOffset, head->itemBuckets, 4));
+    strings = reinterpret_cast<const char*>(section(head->stringOffset, head->stringBytes, 1));
+
+    if (!isPowerOfTwo(head->monsterBuckets) || head->monsterBuckets <= head->monsterCount
+        || !isPowerOfTwo(head->itemBuckets) || head->itemBuckets <= head->itemCount)
+        throw std::runtime_error(source + " has a corrupt name index");
+    for (std::size_t i = 0; i < campaignSize(); ++i)
+        if (campaignList[i] >= head->monsterCount) throw std::runtime_error(source + " has a corrupt campaign");
+    for (std::size_t i = 0; i < inventorySize(); ++i)
+        if (inventoryList[i] >= head->itemCount) throw std::runtime_error(source + " has a corrupt inventory");
+}
+
+std::string_view Catalog::text(std::uint32_t offset, std::uint16_t size) const {
+    if (static_cast<std::uint64_t>(offset) + size > head->stringBytes)
+        throw std::runtime_error("Catalog name out of range");
+    return std::string_view(strings + offset, size);
+}
+
+std::string_view Catalog::name(const CombatantRecord& r) const {
+    return text(r.nameOffset, r.nameLength);
+}
+
+std::string_view Catalog::name(const ItemRecord& r) const {
+    return text(r.nameOffset, r.nameLength);
+}
+
+std::uint32_t Catalog::findMonster(std::string_view n) const {
+    const std::size_t i = findSlot(monsterSlots, head->monsterBuckets, n, [&](std::uint32_t m) {
+        if (m >= head->monsterCount) throw std::runtime_error("Catalog has a corrupt name index");
+        return name(monsters[m]);
+    });
+    return i < head->monsterBuckets && monsterSlots[i] ? monsterSlots[i] - 1 : kNotFound;
+}
+
+std::uint32_t Catalog::findItem(std::string_view n) const {
+    const std::size_t i = findSlot(itemSlots, head->itemBuckets, n, [&](std::uint32_t m) {
+        if (m >= head->itemCount) throw std::runtime_error("Catalog has a corrupt name index");
+        return name(items[m]);
+    });
+    return i < head->itemBuckets && itemSlots[i] ? itemSlots[i] - 1 : kNotFound;
+}
+
+ItemId Catalog::internItem(std::size_t i) const {
+    const ItemRecord& r = items[i];
+    const ItemKind kind = r.kind < static_cast<std::uint8_t>(ItemKind::Count) ? static_cast<ItemKind>(r.kind)
+                                                                               : ItemKind::None;
+    return ItemRegistry::global().intern(name(r), kind);
+}
+
+// ----------------------------
+// CatalogBuilder
+// ----------------------------
+CatalogBuilder::CatalogBuilder()
+    : player(), monsterSlots(kMinBuckets, 0), itemSlots(kMinBuckets, 0) {}
+
+std::uint32_t CatalogBuilder::addName(std::string_view name) {
+    if (name.empty() || name.size() > 0xFFFF) throw std::length_error("Invalid catalog name length");
+    if (strings.size() + name.size() > 0xFFFFFFFFu) throw std::length_error("Catalog string table is full");
+    const std::uint32_t offset = static_cast<std::uint32_t>(strings.size());
+    strings.append(name);
+    return offset;
+}
+
+void CatalogBuilder::setPlayer(std::string_view name, int health, int attack, unsigned char level, unsigned char crit) {
+    player = CombatantRecord{addName(name), static_cast<std::uint16_t>(name.size()), level, crit, health, attack};
+    hasPlayer = true;
+}
+
+std::uint32_t CatalogBuilder::addMonster(std::string_view name, int health, int attack,
+                                         unsigned char level, unsigned char crit) {
+    auto nameAt = [this](std::uint32_t i) { return std::string_view(strings).substr(monsters[i].nameOffset, monsters[i].nameLength); };
+    if (findMonster(name) != Catalog::kNotFound) throw std::runtime_error("Duplicate monster " + std::string(name));
+    if (monsters.size() >= 0xFFFFFFFEu) throw std::length_error("Too many monsters in the catalog");
+
+    reserveSlots(monsterSlots, monsters.size() + 1, nameAt);
+    const std::size_t slot = findSlot(monsterSlots.data(), monsterSlots.size(), name, nameAt);
+    monsters.push_back(CombatantRecord{addName(name), static_cast<std::uint16_t>(name.size()), level, crit, health, attack});
+    monsterSlots[slot] = static_cast<std::uint32_t>(monsters.size());
+    return static_cast<std::uint32_t>(monsters.size() - 1);
+}
+
+std::uint32_t CatalogBuilder::addItem(std::string_view name, ItemKind kind) {
+    auto nameAt = [this](std::uint32_t i) { return std::string_view(strings).substr(items[i].nameOffset, items[i].nameLength); };
+    if (findItem(name) != Catalog::kNotFound) throw std::runtime_error("Duplicate item " + std::string(name));
+    if (items.size() >= 0xFFFFFFFEu) throw std::length_error("Too many items in the catalog");
+
+    reserveSlots(itemSlots, items.size() + 1, nameAt);
+    const std::size_t slot = findSlot(itemSlots.data(), itemSlots.size(), name, nameAt);
+    items.push_back(ItemRecord{addName(name), static_cast<std::uint16_t>(name.size()), static_cast<std::uint8_t>(kind), 0});
+    itemSlots[slot] = static_cast<std::uint32_t>(items.size());
+    return static_cast<std::uint32_t>(items.size() - 1);
+}
+
+void CatalogBuilder::addToCampaign(std::uint32_t monster) {
+    if (monster >= monsters.size()) throw std::out_of_range("Unknown monster index");
+    campaignList.push_back(monster);
+}
+
+void CatalogBuilder::addStartingItem(std::uint32_t item) {
+    if (item >= items.size()) throw std::out_of_range("Unknown item index");
+    if (inventoryList.size() >= Inventory::kCapacity) throw std::length_error("Starting inventory is full");
+    inventoryList.push_back(item);
+}
+
+std::uint32_t CatalogBuilder::findMonster(std::string_view name) const {
+    const std::size_t i = findSlot(monsterSlots.data(), monsterSlots.size(), name, [this](std::uint32_t m) {
+        return std::string_view(strings).substr(monsters[m].nameOffset, monsters[m].nameLength);
+    });
+    return i < monsterSlots.size() && monsterSlots[i] ? monsterSlots[i] - 1 : Catalog::kNotFound;
+}
+
+std::uint32_t CatalogBuilder::findItem(std::string_view name) const {
+    const std::size_t i = findSlot(itemSlots.data(), itemSlots.size(), name, [this](std::uint32_t m) {
+        return std::string_view(strings).substr(items[m].nameOffset, items[m].nameLength);
+    });
+    return i < itemSlots.size() && itemSlots[i] ? itemSlots[i] - 1 : Catalog::kNotFound;
+}
+
+Catalog CatalogBuilder::build() const {
+    CatalogHeader h{};
+    std::memcpy(h.magic, kCatalogMagic, 4);
+    h.version = kCatalogVersion;
+    h.player = player;
+    h.hasPlayer = hasPlayer ? 1 : 0;
+    h.monsterCount = static_cast<std::uint32_t>(monsters.size());
+    h.itemCount = static_cast<std::uint32_t>(items.size());
+    h.campaignCount = static_cast<std::uint32_t>(campaignList.size());
+    h.inventoryCount = static_cast<std::uint32_t>(inventoryList.size());
+    h.monsterBuckets = static_cast<std::uint32_t>(monsterSlots.size());
+    h.itemBuckets = static_cast<std::uint32_t>(itemSlots.size());
+
+    std::size_t offset = align8(sizeof(CatalogHeader));
+    auto place = [&](std::uint64_t& field, std::size_t bytes) {
+        field = offset;
+        offset = align8(offset + bytes);
+    };
+    place(h.monsterOffset, monsters.size() * sizeof(CombatantRecord));
+    place(h.itemOffset, items.size() * sizeof(ItemRecord));
+    place(h.campaignOffset, campaignList.size() * 4);
+    place(h.inventoryOffset, inventoryList.size() * 4);
+    place(h.monsterSlotOffset, monsterSlots.size() * 4);
+    place(h.itemSlotOffset, itemSlots.size() * 4);
+    place(h.stringOffset, strings.size());
+    h.stringBytes = strings.size();
+
+    std::vector<unsigned char> bytes(offset, 0);
+    auto copy = [&](std::uint64_t at, const void* src, std::size_t n) {
+        if (n) std::memcpy(bytes.data() + at, src, n);
+    };
+    copy(0, &h, sizeof(h));
+    copy(h.monsterOffset, monsters.data(), monsters.size() * sizeof(CombatantRecord));
+    copy(h.itemOffset, items.data(), items.size() * sizeof(ItemRecord));
+    copy(h.campaignOffset, campaignList.data(), campaignList.size() * 4);
+    copy(h.inventoryOffset, inventoryList.data(), inventoryList.size() * 4);
+    copy(h.monsterSlotOffset, monsterSlots.data(), monsterSlots.size() * 4);
+    copy(h.itemSlotOffset, itemSlots.data(), itemSlots.size() * 4);
+    copy(h.stringOffset, strings.data(), strings.size());
+    return Catalog(std::move(bytes));
+}
+
+// ----------------------------
+// Laden en opslaan
+// ----------------------------
+Catalog parseCatalog(std::istream& in, const std::string& source) {
+    CatalogBuilder builder;
+    std::string line;
+    std::vector<std::string_view> tokens;
+    std::size_t lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        tokens.clear();
+        for (std::size_t i = 0; i < line.size() && line[i] != '#';) {
+            if (line[i] == ' ' || line[i] == '\t' || line[i] == '\r') {
+                ++i;
+                continue;
+            }
+            std::size_t end = i;
+            while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '\r' && line[end] != '#') ++end;
+            tokens.emplace_back(line.data() + i, end - i);
+            i = end;
+        }
+        if (tokens.empty()) continue;
+
+        try {
+            const std::string_view directive = tokens[0];
+            if (directive == "player" || directive == "monster") {
+                if (tokens.size() != 6) throw std::runtime_error("expected " + std::string(directive) + " <name> <hp> <attack> <level> <crit>");
+                const int health = parseNumber(tokens[2], 1, 1000000000, "hp");
+                const int attack = parseNumber(tokens[3], 0, 1000000000, "attack");
+                const auto level = static_cast<unsigned char>(parseNumber(tokens[4], 0, 255, "level"));
+                const auto crit = static_cast<unsigned char>(parseNumber(tokens[5], 0, 100, "crit"));
+                if (directive == "player") builder.setPlayer(tokens[1], health, attack, level, crit);
+                else builder.addMonster(tokens[1], health, attack, level, crit);
+            } else if (directive == "item") {
+                if (tokens.size() < 2 || tokens.size() > 3) throw std::runtime_error("expected item <name> [effect]");
+                ItemKind kind = itemKind(tokens.size() == 3 ? tokens[2] : tokens[1]);
+                if (tokens.size() == 3 && kind == ItemKind::None && tokens[2] != "None")
+                    throw std::runtime_error("unknown item effect '" + std::string(tokens[2]) + "'");
+                builder.addItem(tokens[1], kind);
+            } else if (directive == "campaign") {
+                for (std::size_t i = 1; i < tokens.size(); ++i) {
+                    const std::uint32_t m = builder.findMonster(tokens[i]);
+                    if (m == Catalog::kNotFound) throw std::runtime_error("unknown monster '" + std::string(tokens[i]) + "'");
+                    builder.addToCampaign(m);
+                }
+            } else if (directive == "inventory") {
+                for (std::size_t i = 1; i < tokens.size(); ++i) {
+                    const std::uint32_t item = builder.findItem(tokens[i]);
+                    if (item == Catalog::kNotFound) throw std::runtime_error("unknown item '" + std::string(tokens[i]) + "'");
+                    builder.addStartingItem(item);
+                }
+            } else {
+                throw std::runtime_error("unknown directive '" + std::string(directive) + "'");
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error(source + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    if (in.bad()) throw std::ios_base::failure("File I/O error: cannot read " + source);
+    return builder.build();
+}
+
+Catalog loadCatalog(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::ios_base::failure("Cannot open " + path);
+
+    char magic[4] = {};
+    in.read(magic, sizeof(magic));
+    if (in.gcount() == 4 && std::memcmp(magic, kCatalogMagic, 4) == 0) {
+        in.close();
+        return Catalog(std::make_unique<MappedFile>(path), path);
+    }
+    in.clear();
+    in.seekg(0);
+    return parseCatalog(in, path);
+}
+
+void saveCatalog(const std::string& path, const Catalog& catalog) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::ios_base::failure("Cannot open " + path);
+    out.write(reinterpret_cast<const char*>(catalog.data()), static_cast<std::streamsize>(catalog.size()));
+    if (!out) throw std::ios_base::failure("Cannot write " + path);
+}
+
+} // namespace rpg
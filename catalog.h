@@ -0,0 +1,186 @@
+#pragma once
+#include "items.h"
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Catalogus formaat
+// ----------------------------
+// Tekst (één definitie per regel, # is commentaar, namen zonder spaties):
+//   player    <naam> <hp> <attack> <level> <crit>
+//   monster   <naam> <hp> <attack> <level> <crit>
+//   item      <naam> [Sword|Shield|Potion|None]   effect, standaard op naam
+//   campaign  <monster>...                        roster volgorde, mag vaker
+//   inventory <item>...                           start inventory van de speler
+// Een campaign of inventory regel mag alleen eerder gedefinieerde namen
+// gebruiken, zodat de loader in één pass door de stream kan.
+//
+// Binair (native little-endian), direct bruikbaar vanuit een memory map:
+//   CatalogHeader
+//   CombatantRecord[monsterCount]
+//   ItemRecord[itemCount]
+//   u32 campaign[campaignCount], u32 inventory[inventoryCount]
+//   u32 monsterSlots[monsterBuckets], u32 itemSlots[itemBuckets]
+//   string table (namen achter elkaar, zonder terminator)
+// De slots zijn een open addressing hash tabel (FNV-1a, lineair proberen,
+// index + 1, 0 = leeg), zodat zoeken op naam niets hoeft op te bouwen.
+struct CombatantRecord {
+    std::uint32_t nameOffset;
+    std::uint16_t nameLength;
+    std::uint8_t level;
+    std::uint8_t criticalChance;
+    std::int32_t health;
+    std::int32_t attackPower;
+};
+static_assert(sizeof(CombatantRecord) == 16, "CombatantRecord must stay 16 bytes");
+
+struct ItemRecord {
+    std::uint32_t nameOffset;
+    std::uint16_t nameLength;
+    std::uint8_t kind;       // ItemKind
+    std::uint8_t reserved;
+};
+static_assert(sizeof(ItemRecord) == 8, "ItemRecord must stay 8 bytes");
+
+struct CatalogHeader {
+    char magic[4];
+    std::uint32_t version;
+    CombatantRecord player;
+    std::uint32_t hasPlayer;
+    std::uint32_t monsterCount;
+    std::uint32_t itemCount;
+    std::uint32_t campaignCount;
+    std::uint32_t inventoryCount;
+    std::uint32_t monsterBuckets;
+    std::uint32_t itemBuckets;
+    std::uint32_t reserved;
+    std::uint64_t monsterOffset;
+    std::uint64_t itemOffset;
+    std::uint64_t campaignOffset;
+    std::uint64_t inventoryOffset;
+    std::uint64_t monsterSlotOffset;
+    std::uint64_t itemSlotOffset;
+    std::uint64_t stringOffset;
+    std::uint64_t stringBytes;
+};
+static_assert(sizeof(CatalogHeader) == 120, "CatalogHeader must stay 120 bytes");
+
+// ----------------------------
+// Catalog
+// ----------------------------
+// Alleen-lezen catalogus van monsters en items. Het geheugen is altijd de
+// binaire vorm: een gemapt bestand (loadCatalog op een binair bestand) of
+// een eigen buffer (CatalogBuilder, tekst loader). Openen van een binair
+// bestand kost daardoor alleen een mmap en een paar bound checks.
+class Catalog {
+public:
+    static constexpr std::uint32_t kNotFound = 0xFFFFFFFFu;
+
+    Catalog();   // leeg
+    Catalog(Catalog&&) = default;
+    Catalog& operator=(Catalog&&) = default;
+
+    inline std::size_t monsterCount() const { return head->monsterCount; }
+    inline std::size_t itemCount() const { return head->itemCount; }
+    inline const CombatantRecord& monster(std::size_t i) const { return monsters[i]; }
+    inline const ItemRecord& item(std::size_t i) const { return items[i]; }
+
+    inline bool hasPlayer() const { return head->hasPlayer != 0; }
+    inline const CombatantRecord& player() const { return head->player; }
+
+    inline std::size_t campaignSize() const { return head->campaignCount; }
+    inline std::uint32_t campaign(std::size_t i) const { return campaignList[i]; }   // monster index
+    inline std::size_t inventorySize() const { return head->inventoryCount; }
+    inline std::uint32_t startingItem(std::size_t i) const { return inventoryList[i]; }   // item index
+
+    std::string_view name(const CombatantRecord& r) const;
+    std::string_view name(const ItemRecord& r) const;
+
+    std::uint32_t findMonster(std::string_view name) const;   // kNotFound als onbekend
+    std::uint32_t findItem(std::string_view name) const;
+
+    // Het item in de ItemRegistry, met het effect uit de catalogus.
+    ItemId internItem(std::size_t i) const;
+
+    // De bytes van het binaire formaat.
+    inline const unsigned char* data() const { return base; }
+    inline std::size_t size() const { return length; }
+
+private:
+    friend class CatalogBuilder;
+    friend Catalog loadCatalog(const std::string& path);
+
+    explicit Catalog(std::vector<unsigned char> bytes);
+    Catalog(std::unique_ptr<MappedFile> file, const std::string& source);
+    void attach(const unsigned char* bytes, std::size_t size, const std::string& source);
+    std::string_view text(std::uint32_t offset, std::uint16_t length) const;
+
+    std::vector<unsigned char> image;
+    std::unique_ptr<MappedFile> mapped;
+    const unsigned char* base;
+    std::size_t length;
+    const CatalogHeader* head;
+    const CombatantRecord* monsters;
+    const ItemRecord* items;
+    const std::uint32_t* campaignList;
+    const std::uint32_t* inventoryList;
+    const std::uint32_t* monsterSlots;
+    const std::uint32_t* itemSlots;
+    const char* strings;
+};
+
+// ----------------------------
+// CatalogBuilder
+// ----------------------------
+// Gooit std::runtime_error bij dubbele namen en std::length_error als de
+// start inventory niet in een Inventory past.
+class CatalogBuilder {
+public:
+    CatalogBuilder();
+
+    void setPlayer(std::string_view name, int health, int attack, unsigned char level, unsigned char crit);
+    std::uint32_t addMonster(std::string_view name, int health, int attack, unsigned char level, unsigned char crit);
+    std::uint32_t addItem(std::string_view name, ItemKind kind);
+
+    void addToCampaign(std::uint32_t monster);
+    void addStartingItem(std::uint32_t item);
+
+    std::uint32_t findMonster(std::string_view name) const;   // Catalog::kNotFound als onbekend
+    std::uint32_t findItem(std::string_view name) const;
+
+    Catalog build() const;
+
+private:
+    std::uint32_t addName(std::string_view name);
+
+    std::string strings;
+    CombatantRecord player;
+    bool hasPlayer = false;
+    std::vector<CombatantRecord> monsters;
+    std::vector<ItemRecord> items;
+    std::vector<std::uint32_t> monsterSlots;
+    std::vector<std::uint32_t> itemSlots;
+    std::vector<std::uint32_t> campaignList;
+    std::vector<std::uint32_t> inventoryList;
+};
+
+// ----------------------------
+// Laden en opslaan
+// ----------------------------
+// parseCatalog leest de tekst vorm regel voor regel; fouten geven een
+// std::runtime_error met "<source>:<regel>: ...". loadCatalog herkent de
+// binaire vorm aan de magic en mapt die, anders wordt het bestand als
+// tekst gelezen.
+Catalog parseCatalog(std::istream& in, const std::string& source = "catalog");
+Catalog loadCatalog(const std::string& path);
+void saveCatalog(const std::string& path, const Catalog& catalog);
+
+} // namespace rpg
@@ -0,0 +1,129 @@
+#include "combatant_pool.h"
+#include "damage_pipeline.h"
+#include <algorithm>
+#include <cassert>
+
+namespace rpg {
+
+// ----------------------------
+// WaveRolls
+// ----------------------------
+void WaveRolls::draw(Rng& rng, const CombatantPool& pool) {
+    const std::size_t count = pool.size();
+    critRoll.assign(count, 101);   // dode slots: nooit crit, geen damage
+    variation.assign(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!pool.isAlive(i)) continue;
+        critRoll[i] = rng.uniformInt(1, 100);
+        variation[i] = rng.uniformInt(8, 12);
+    }
+}
+
+// ----------------------------
+// Damage kernels
+// ----------------------------
+// StandardDamage is dezelfde integer pipeline als Character::strike; crit en
+// shield zijn shifts, dus de lussen zijn zonder branches en vectoriseerbaar.
+namespace {
+
+inline int waveDamage(int raw, int critRoll, int chance, int variation, bool shield, unsigned char& crit) {
+    const bool isCrit = critRoll <= chance;
+    crit = static_cast<unsigned char>(isCrit);
+    DamageContext ctx;
+    ctx.raw = raw;
+    ctx.variation = variation;
+    ctx.critical = isCrit;
+    ctx.shielded = shield;
+    return StandardDamage::apply(ctx);
+}
+
+} // namespace
+
+// ----------------------------
+// CombatantPool
+// ----------------------------
+void CombatantPool::reserve(std::size_t n) {
+    health.reserve(n);
+    attackPower.reserve(n);
+    criticalChance.reserve(n);
+    flags.reserve(n);
+    maxHealth.reserve(n);
+    levels.reserve(n);
+    names.reserve(n);
+}
+
+std::size_t CombatantPool::add(const Character& c) {
+    unsigned char f = 0;
+    if (c.isStunned) f |= Stunned;
+    if (c.hasShield) f |= Shield;
+    if (c.criticalActive) f |= CriticalActive;
+    if (c.isPoisoned) f |= Poisoned;
+
+    health.push_back(c.health);
+    attackPower.push_back(c.attackPower + c.attackBonus);
+    criticalChance.push_back(c.criticalChance);
+    flags.push_back(f);
+    maxHealth.push_back(c.maxHealth);
+    levels.push_back(c.level);
+    names.push_back(c.name);
+    return health.size() - 1;
+}
+
+void CombatantPool::clear() {
+    health.clear();
+    attackPower.clear();
+    criticalChance.clear();
+    flags.clear();
+    maxHealth.clear();
+    levels.clear();
+    names.clear();
+}
+
+void CombatantPool::setFlag(std::size_t i, Flag f, bool on) {
+    if (on) flags[i] |= f;
+    else flags[i] &= static_cast<unsigned char>(~f);
+}
+
+std::size_t CombatantPool::aliveCount() const {
+    return static_cast<std::size_t>(std::count_if(health.begin(), health.end(),
+                                                  [](int h) { return h > 0; }));
+}
+
+void CombatantPool::strikeAll(Character& attacker, int multiplier, const WaveRolls& rolls, WaveResult& out) {
+    const std::size_t n = size();
+    assert(rolls.size() >= n);
+    out.damage.assign(n, 0);
+    out.critical.assign(n, 0);
+    out.totalDamage = 0;
+
+    if (attacker.isStunned) {
+        attacker.isStunned = false;
+        return;
+    }
+
+    const int raw = calculateDamage<int>(attacker.attackPower + attacker.attackBonus, multiplier);
+    const int chance = attacker.criticalChance;
+    const int* critRoll = rolls.critRoll.data();
+    const int* variation = rolls.variation.data();
+    const unsigned char* f = flags.data();
+    int* hp = health.data();
+    int* dmgOut = out.damage.data();
+    unsigned char* critOut = out.critical.data();
+
+    int total = 0;
+    unsigned char lastCrit = attacker.criticalActive;   // van de laatste levende slot
+    for (std::size_t i = 0; i < n; ++i) {
+        const int active = hp[i] > 0;
+        const bool shield = (f[i] & Shield) != 0;
+        const int dmg = waveDamage(raw, critRoll[i], chance, variation[i], shield, critOut[i]) * active;
+        critOut[i] = static_cast<unsigned char>(critOut[i] & active);
+        lastCrit = active ? critOut[i] : lastCrit;
+        dmgOut[i] = dmg;
+        hp[i] = std::max(hp[i] - dmg, 0);
+        total += dmg;
+    }
+    out.totalDamage = total;
+    attacker.criticalActive = lastCrit != 0;
+}
+
+} // namespace rpg
@@ -0,0 +1,80 @@
+#pragma once
+#include "rpg_classes.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rpg {
+
+class CombatantPool;
+
+// ----------------------------
+// Vooraf getrokken rolls voor een wave
+// ----------------------------
+// Per aanval eerst de crit roll (1..100) en daarna de variatie (8..12),
+// in dezelfde volgorde als Character::strike de RNG gebruikt. Alleen
+// levende slots krijgen rolls, zodat de stream gelijk blijft aan strike()
+// op elke levende combatant in slot volgorde. Een gestunde aanvaller slaat
+// de hele wave over: trek dan geen rolls.
+struct WaveRolls {
+    std::vector<int> critRoll;
+    std::vector<int> variation;
+
+    void draw(Rng& rng, const CombatantPool& pool);
+    inline std::size_t size() const { return critRoll.size(); }
+};
+
+struct WaveResult {
+    std::vector<int> damage;
+    std::vector<unsigned char> critical;
+    int totalDamage = 0;
+};
+
+// ----------------------------
+// CombatantPool: struct-of-arrays opslag
+// ----------------------------
+// De hete combat stats staan in aaneengesloten parallelle arrays; namen en
+// levels (alleen nodig voor output) staan apart. Status effecten zitten als
+// bits in een enkele byte per combatant.
+class CombatantPool {
+public:
+    enum Flag : unsigned char {
+        Stunned = 1 << 0,
+        Shield = 1 << 1,
+        CriticalActive = 1 << 2,
+        Poisoned = 1 << 3
+    };
+
+private:
+    // hot
+    std::vector<int> health;
+    std::vector<int> attackPower;
+    std::vector<unsigned char> criticalChance;
+    std::vector<unsigned char> flags;
+    // cold
+    std::vector<int> maxHealth;
+    std::vector<unsigned char> levels;
+    std::vector<std::string> names;
+
+public:
+    void reserve(std::size_t n);
+    std::size_t add(const Character& c);
+    void clear();
+
+    inline std::size_t size() const { return health.size(); }
+    inline const std::string& getName(std::size_t i) const { return names[i]; }
+    inline int getHealth(std::size_t i) const { return health[i]; }
+    inline int getMaxHealth(std::size_t i) const { return maxHealth[i]; }
+    inline unsigned char getLevel(std::size_t i) const { return levels[i]; }
+    inline bool isAlive(std::size_t i) const { return health[i] > 0; }
+    inline bool hasFlag(std::size_t i, Flag f) const { return (flags[i] & f) != 0; }
+    void setFlag(std::size_t i, Flag f, bool on);
+    std::size_t aliveCount() const;
+
+    // Eén aanvaller raakt elke levende combatant in de wave (rolls[i] hoort
+    // bij slot i); dode slots krijgen geen damage.
+    void strikeAll(Character& attacker, int multiplier, const WaveRolls& rolls, WaveResult& out);
+};
+
+} // namespace rpg
@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpg {
+
+// ----------------------------
+// Damage context
+// ----------------------------
+// De discrete invoer van één hit. raw is attackPower * multiplier
+// (calculateDamage<int>), variation komt uit de roll 8..12.
+enum class Element : std::uint8_t {
+    None,
+    Fire,
+    Ice,
+    Lightning,
+    Count
+};
+
+struct DamageContext {
+    int raw = 0;
+    int variation = 10;
+    bool critical = false;
+    bool shielded = false;
+    unsigned char attackerLevel = 1;
+    unsigned char defenderLevel = 1;
+    Element attackElement = Element::None;
+    Element defenderElement = Element::None;
+};
+
+// ----------------------------
+// Modifiers
+// ----------------------------
+// Elke modifier levert een integer factor (scale) met een vaste noemer
+// (denominator) en een stap na het afkappen (post). De pipeline
+// vermenigvuldigt alle factoren in 64-bit, deelt één keer door het product
+// van de noemers (een compile-time constante) en past daarna de post stappen
+// toe. Zo blijft het afronden gelijk aan het oude double pad.
+struct VariationModifier {
+    static constexpr std::int64_t denominator = 10;
+    static constexpr std::int64_t scale(const DamageContext& c) { return c.variation; }
+    static constexpr int post(const DamageContext&, int dmg) { return dmg; }
+};
+
+struct CriticalModifier {
+    static constexpr std::int64_t denominator = 1;
+    static constexpr std::int64_t scale(const DamageContext& c) { return 1 + static_cast<int>(c.critical); }
+    static constexpr int post(const DamageContext&, int dmg) { return dmg; }
+};
+
+// Halveert na het afkappen, zoals dmg /= 2 in het oude pad (damage >= 0).
+struct ShieldModifier {
+    static constexpr std::int64_t denominator = 1;
+    static constexpr std::int64_t scale(const DamageContext&) { return 1; }
+    static constexpr int post(const DamageContext& c, int dmg) { return dmg >> static_cast<int>(c.shielded); }
+};
+
+// PercentPerLevel extra (of minder) damage per level verschil, nooit onder 0%.
+template<int PercentPerLevel>
+struct LevelScalingModifier {
+    static constexpr std::int64_t denominator = 100;
+    static constexpr std::int64_t scale(const DamageContext& c) {
+        const std::int64_t pct = 100 + PercentPerLevel * (static_cast<int>(c.attackerLevel) - static_cast<int>(c.defenderLevel));
+        return pct < 0 ? 0 : pct;
+    }
+    static constexpr int post(const DamageContext&, int dmg) { return dmg; }
+};
+
+// Percentage per (aanval element, verdediger element).
+constexpr std::size_t kElementCount = static_cast<std::size_t>(Element::Count);
+constexpr std::array<std::array<int, kElementCount>, kElementCount> kElementChart = {{
+    //           None  Fire  Ice  Lightning
+    /* None */  {{100, 100, 100, 100}},
+    /* Fire */  {{100,  50, 200, 100}},
+    /* Ice  */  {{100,  50,  50, 200}},
+    /* Light */ {{100, 200,  50,  50}},
+}};
+
+struct ElementalModifier {
+    static constexpr std::int64_t denominator = 100;
+    static constexpr std::int64_t scale(const DamageContext& c) {
+        return kElementChart[static_cast<std::size_t>(c.attackElement)][static_cast<std::size_t>(c.defenderElement)];
+    }
+    static constexpr int post(const DamageContext&, int dmg) { return dmg; }
+};
+
+// ----------------------------
+// Lookup table: variation 8..12 x crit x shield
+// ----------------------------
+struct DamageTable {
+    static constexpr int kMinVariation = 8;
+    static constexpr int kMaxVariation = 12;
+    static constexpr std::size_t kSize = (kMaxVariation - kMinVariation + 1) * 4;
+
+    std::array<int, kSize> values{};
+
+    static constexpr std::size_t index(int variation, bool critical, bool shielded) {
+        return static_cast<std::size_t>(variation - kMinVariation) * 4
+               + static_cast<std::size_t>(critical) * 2 + static_cast<std::size_t>(shielded);
+    }
+    constexpr int operator()(int variation, bool critical, bool shielded) const {
+        return values[index(variation, critical, shielded)];
+    }
+};
+
+// ----------------------------
+// DamagePipeline
+// ----------------------------
+template<typename... Modifiers>
+struct DamagePipeline {
+    static constexpr std::int64_t denominator = (std::int64_t{1} * ... * Modifiers::denominator);
+
+    static constexpr int apply(const DamageContext& c) {
+        std::int64_t num = c.raw;
+        ((num *= Modifiers::scale(c)), ...);
+        int dmg = static_cast<int>(num / denominator);
+        ((dmg = Modifiers::post(c, dmg)), ...);
+        return dmg;
+    }
+
+    // Alle 20 combinaties voor een vaste context (raw, levels, elementen).
+    // Met een compile-time context is de hele tabel een constante.
+    static constexpr DamageTable table(DamageContext base) {
+        DamageTable t;
+        for (int v = DamageTable::kMinVariation; v <= DamageTable::kMaxVariation; ++v)
+            for (int crit = 0; crit < 2; ++crit)
+                for (int shield = 0; shield < 2; ++shield) {
+                    base.variation = v;
+                    base.critical = crit != 0;
+                    base.shielded = shield != 0;
+                    t.values[DamageTable::index(v, crit != 0, shield != 0)] = apply(base);
+                }
+        return t;
+    }
+};
+
+// De regels van Character::strike: variatie, crit verdubbeling, shield.
+using StandardDamage = DamagePipeline<VariationModifier, CriticalModifier, ShieldModifier>;
+
+// Uitbreidingen voor later (levels en elementen).
+using ExtendedDamage = DamagePipeline<VariationModifier, CriticalModifier,
+                                      LevelScalingModifier<10>, ElementalModifier, ShieldModifier>;
+
+// ----------------------------
+// Generiek pad
+// ----------------------------
+// Het oorspronkelijke double pad, voor tools en om de pipeline tegen te
+// controleren.
+constexpr int genericDamage(int raw, int variation, bool critical, bool shielded) {
+    int dmg = static_cast<int>(raw * (variation / 10.0 * (critical ? 2.0 : 1.0)));
+    if (shielded) dmg /= 2;
+    return dmg;
+}
+
+} // namespace rpg
@@ -0,0 +1,290 @@
+#include "instrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace rpg {
+
+namespace {
+
+// ----------------------------
+// Per-thread blok
+// ----------------------------
+// Alleen de eigen thread schrijft; snapshot() leest mee. Daarom relaxed
+// atomics met load + store in plaats van een read-modify-write.
+inline void bump(std::atomic<std::uint64_t>& cell, std::uint64_t n) {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline std::size_t bucketOf(std::uint64_t ns) {
+    std::size_t bits;
+#if defined(__GNUC__) || defined(__clang__)
+    bits = ns ? 64 - static_cast<std::size_t>(__builtin_clzll(ns)) : 0;
+#else
+    bits = 0;
+    while (ns) { ++bits; ns >>= 1; }
+#endif
+    return std::min(bits, PhaseStats::kBuckets - 1);
+}
+
+struct PhaseCells {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+    std::array<std::atomic<std::uint64_t>, PhaseStats::kBuckets> buckets{};
+};
+
+struct alignas(64) ThreadBlock {
+    std::uint32_t thread = 0;
+    std::array<PhaseCells, kPhaseCount> phases;
+    std::array<std::atomic<std::uint64_t>, kCounterCount> counters{};
+    std::mutex traceMutex;
+    std::vector<TraceEvent> trace;
+
+    void addTo(InstrumentationSnapshot& s) {
+        for (std::size_t p = 0; p < kPhaseCount; ++p) {
+            PhaseStats& out = s.phases[p];
+            const PhaseCells& in = phases[p];
+            out.count += in.count.load(std::memory_order_relaxed);
+            out.totalNs += in.totalNs.load(std::memory_order_relaxed);
+            out.maxNs = std::max(out.maxNs, in.maxNs.load(std::memory_order_relaxed));
+            for (std::size_t b = 0; b < PhaseStats::kBuckets; ++b)
+                out.buckets[b] += in.buckets[b].load(std::memory_order_relaxed);
+        }
+        for (std::size_t c = 0; c < kCounterCount; ++c)
+            s.counters[c] += counters[c].load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(traceMutex);
+        s.trace.insert(s.trace.end(), trace.begin(), trace.end());
+    }
+
+    void clear() {
+        for (PhaseCells& c : phases) {
+            c.count.store(0, std::memory_order_relaxed);
+            c.totalNs.store(0, std::memory_order_relaxed);
+            c.maxNs.store(0, std::memory_order_relaxed);
+            for (auto& b : c.buckets) b.store(0, std::memory_order_relaxed);
+        }
+        for (auto& c : counters) c.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(traceMutex);
+        trace.clear();
+    }
+};
+
+// ----------------------------
+// Registry van alle threads
+// ----------------------------
+std::atomic<std::size_t> traceLimit{0};   // 0 = geen trace
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadBlock*> live;
+    InstrumentationSnapshot retired;   // opgeteld bij het afsluiten van threads
+    std::uint32_t nextThread = 1;
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// Meldt het blok aan bij de eerste meting op een thread en voegt het samen
+// met retired als de thread stopt.
+struct ThreadHandle {
+    std::unique_ptr<ThreadBlock> block = std::make_unique<ThreadBlock>();
+
+    ThreadHandle() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        block->thread = r.nextThread++;
+        r.live.push_back(block.get());
+    }
+
+    ~ThreadHandle() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        block->addTo(r.retired);
+        r.live.erase(std::find(r.live.begin(), r.live.end(), block.get()));
+    }
+};
+
+ThreadBlock& localBlock() {
+    thread_local ThreadHandle handle;
+    return *handle.block;
+}
+
+void writePhaseName(std::ostream& os, std::size_t p) {
+    os << '"' << phaseName(static_cast<Phase>(p)) << '"';
+}
+
+} // namespace
+
+// ----------------------------
+// Namen
+// ----------------------------
+const char* phaseName(Phase phase) {
+    switch (phase) {
+    case Phase::Attack: return "attack";
+    case Phase::Damage: return "damage";
+    case Phase::Output: return "output";
+    case Phase::LogAttack: return "log_attack";
+    case Phase::LogStatus: return "log_status";
+    case Phase::Heal: return "heal";
+    case Phase::Turn: return "turn";
+    case Phase::LogWrite: return "log_write";
+    case Phase::Count: break;
+    }
+    return "unknown";
+}
+
+const char* counterName(Counter counter) {
+    switch (counter) {
+    case Counter::Attacks: return "attacks";
+    case Counter::CriticalHits: return "critical_hits";
+    case Counter::ShieldHits: return "shield_hits";
+    case Counter::StunnedTurns: return "stunned_turns";
+    case Counter::Heals: return "heals";
+    case Counter::BytesLogged: return "bytes_logged";
+    case Counter::Count: break;
+    }
+    return "unknown";
+}
+
+// ----------------------------
+// PhaseStats
+// ----------------------------
+void PhaseStats::add(std::uint64_t ns) {
+    ++count;
+    totalNs += ns;
+    maxNs = std::max(maxNs, ns);
+    ++buckets[bucketOf(ns)];
+}
+
+double PhaseStats::meanNs() const {
+    return count ? static_cast<double>(totalNs) / static_cast<double>(count) : 0.0;
+}
+
+std::uint64_t PhaseStats::percentileNs(double p) const {
+    if (!count) return 0;
+    std::uint64_t target = static_cast<std::uint64_t>(p * static_cast<double>(count));
+    if (target >= count) target = count - 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+        seen += buckets[b];
+        if (seen > target) return b ? std::min(std::uint64_t{1} << b, maxNs) : 0;
+    }
+    return maxNs;
+}
+
+void PhaseStats::merge(const PhaseStats& other) {
+    count += other.count;
+    totalNs += other.totalNs;
+    maxNs = std::max(maxNs, other.maxNs);
+    for (std::size_t b = 0; b < kBuckets; ++b) buckets[b] += other.buckets[b];
+}
+
+// ----------------------------
+// Instrumentation
+// ----------------------------
+void Instrumentation::record(Phase phase, std::uint64_t startNs, std::uint64_t durationNs) {
+    ThreadBlock& block = localBlock();
+    PhaseCells& cells = block.phases[static_cast<std::size_t>(phase)];
+    bump(cells.count, 1);
+    bump(cells.totalNs, durationNs);
+    if (durationNs > cells.maxNs.load(std::memory_order_relaxed))
+        cells.maxNs.store(durationNs, std::memory_order_relaxed);
+    bump(cells.buckets[bucketOf(durationNs)], 1);
+
+    if (std::size_t limit = traceLimit.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(block.traceMutex);
+        if (block.trace.size() < limit)
+            block.trace.push_back({phase, block.thread, startNs, durationNs});
+    }
+}
+
+void Instrumentation::add(Counter counter, std::uint64_t n) {
+    bump(localBlock().counters[static_cast<std::size_t>(counter)], n);
+}
+
+void Instrumentation::enableTrace(std::size_t maxEventsPerThread) {
+    traceLimit.store(maxEventsPerThread, std::memory_order_relaxed);
+}
+
+void Instrumentation::disableTrace() {
+    traceLimit.store(0, std::memory_order_relaxed);
+}
+
+InstrumentationSnapshot Instrumentation::snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    InstrumentationSnapshot s = r.retired;
+    for (ThreadBlock* block : r.live) block->addTo(s);
+    std::sort(s.trace.begin(), s.trace.end(),
+              [](const TraceEvent& a, const TraceEvent& b) { return a.startNs < b.startNs; });
+    return s;
+}
+
+void Instrumentation::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = InstrumentationSnapshot{};
+    for (ThreadBlock* block : r.live) block->clear();
+}
+
+// ----------------------------
+// Dumps
+// ----------------------------
+void Instrumentation::writeJson(std::ostream& os, const InstrumentationSnapshot& s) {
+    os << "{\n  \"enabled\": " << (RPG_INSTRUMENTATION ? "true" : "false") << ",\n  \"phases\": {\n";
+    for (std::size_t p = 0; p < kPhaseCount; ++p) {
+        const PhaseStats& ps = s.phases[p];
+        os << "    ";
+        writePhaseName(os, p);
+        os << ": {\"count\": " << ps.count << ", \"total_ns\": " << ps.totalNs
+           << ", \"mean_ns\": " << ps.meanNs() << ", \"p50_ns\": " << ps.percentileNs(0.5)
+           << ", \"p99_ns\": " << ps.percentileNs(0.99) << ", \"max_ns\": " << ps.maxNs
+           << ", \"log2_histogram\": [";
+        std::size_t last = PhaseStats::kBuckets;
+        while (last > 0 && ps.buckets[last - 1] == 0) --last;
+        for (std::size_t b = 0; b < last; ++b) os << (b ? ", " : "") << ps.buckets[b];
+        os << "]}" << (p + 1 < kPhaseCount ? ",\n" : "\n");
+    }
+    os << "  },\n  \"counters\": {\n";
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        os << "    \"" << counterName(static_cast<Counter>(c)) << "\": " << s.counters[c]
+           << (c + 1 < kCounterCount ? ",\n" : "\n");
+    }
+    os << "  }\n}\n";
+}
+
+// Chrome trace event formaat (chrome://tracing, Perfetto): complete events
+// in microseconden, plus de counters als één counter event aan het eind.
+void Instrumentation::writeChromeTrace(std::ostream& os, const InstrumentationSnapshot& s) {
+    const std::uint64_t origin = s.trace.empty() ? 0 : s.trace.front().startNs;
+    std::uint64_t end = 0;
+    const auto oldFlags = os.flags();
+    const auto oldPrecision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    for (const TraceEvent& e : s.trace) {
+        os << "  {\"name\": ";
+        writePhaseName(os, static_cast<std::size_t>(e.phase));
+        os << ", \"cat\": \"rpg\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << e.thread
+           << ", \"ts\": " << static_cast<double>(e.startNs - origin) / 1000.0
+           << ", \"dur\": " << static_cast<double>(e.durationNs) / 1000.0 << "},\n";
+        end = std::max(end, e.startNs - origin + e.durationNs);
+    }
+    os << "  {\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"ts\": "
+       << static_cast<double>(end) / 1000.0 << ", \"args\": {";
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        os << (c ? ", " : "") << '"' << counterName(static_cast<Counter>(c)) << "\": " << s.counters[c];
+    }
+    os << "}}\n]}\n";
+
+    os.flags(oldFlags);
+    os.precision(oldPrecision);
+}
+
+} // namespace rpg
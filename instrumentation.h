@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// ----------------------------
+// Instrumentatie schakelaar
+// ----------------------------
+// Zonder RPG_INSTRUMENTATION (CMake optie van dezelfde naam) zijn de macro's
+// leeg en kost de instrumentatie niets; de query/dump API blijft bestaan en
+// geeft dan een lege snapshot.
+#ifndef RPG_INSTRUMENTATION
+#define RPG_INSTRUMENTATION 0
+#endif
+
+namespace rpg {
+
+// ----------------------------
+// Fases en counters
+// ----------------------------
+enum class Phase : std::uint8_t {
+    Attack,      // Character::attack totaal
+    Damage,      // strike: rolls en damage pipeline
+    Output,      // console formattering van de aanval
+    LogAttack,   // event in de logger ring buffer zetten
+    LogStatus,   // BattleLogger::logStatus
+    Heal,        // Player::heal
+    Turn,        // één ronde in Game::start
+    LogWrite,    // batch naar het logbestand (writer thread)
+    Count
+};
+
+enum class Counter : std::uint8_t {
+    Attacks,
+    CriticalHits,
+    ShieldHits,
+    StunnedTurns,
+    Heals,
+    BytesLogged,
+    Count
+};
+
+constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::Count);
+constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::Count);
+
+const char* phaseName(Phase phase);
+const char* counterName(Counter counter);
+
+// ----------------------------
+// Resultaten
+// ----------------------------
+// Latency histogram met log2 buckets: bucket b telt samples in [2^(b-1), 2^b) ns.
+struct PhaseStats {
+    static constexpr std::size_t kBuckets = 40;
+
+    std::uint64_t count = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t maxNs = 0;
+    std::array<std::uint64_t, kBuckets> buckets{};
+
+    void add(std::uint64_t ns);
+    double meanNs() const;
+    std::uint64_t percentileNs(double p) const;   // bovengrens van de bucket, hooguit maxNs
+    void merge(const PhaseStats& other);
+};
+
+struct TraceEvent {
+    Phase phase;
+    std::uint32_t thread;
+    std::uint64_t startNs;   // steady_clock tijd in ns
+    std::uint64_t durationNs;
+};
+
+struct InstrumentationSnapshot {
+    std::array<PhaseStats, kPhaseCount> phases{};
+    std::array<std::uint64_t, kCounterCount> counters{};
+    std::vector<TraceEvent> trace;
+
+    inline const PhaseStats& operator[](Phase p) const { return phases[static_cast<std::size_t>(p)]; }
+    inline std::uint64_t operator[](Counter c) const { return counters[static_cast<std::size_t>(c)]; }
+};
+
+// ----------------------------
+// Instrumentation
+// ----------------------------
+// Elke thread schrijft in zijn eigen blok (geen locks, geen gedeelde cache
+// lines). snapshot() telt de blokken van levende threads op bij wat beëindigde
+// threads al hebben achtergelaten. Trace events worden alleen bewaard na
+// enableTrace(), met een limiet per thread.
+class Instrumentation {
+public:
+    static void record(Phase phase, std::uint64_t startNs, std::uint64_t durationNs);
+    static void add(Counter counter, std::uint64_t n = 1);
+
+    static void enableTrace(std::size_t maxEventsPerThread = 1 << 16);
+    static void disableTrace();
+
+    static InstrumentationSnapshot snapshot();
+    static void reset();   // alleen aanroepen als er geen gemeten code loopt
+
+    static void writeJson(std::ostream& os, const InstrumentationSnapshot& s);
+    static void writeChromeTrace(std::ostream& os, const InstrumentationSnapshot& s);
+
+    static inline std::uint64_t now() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+class ScopedTimer {
+private:
+    Phase phase;
+    std::uint64_t start;
+
+public:
+    explicit ScopedTimer(Phase p) : phase(p), start(Instrumentation::now()) {}
+    ~ScopedTimer() { Instrumentation::record(phase, start, Instrumentation::now() - start); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+} // namespace rpg
+
+#define RPG_INSTR_CONCAT2(a, b) a##b
+#define RPG_INSTR_CONCAT(a, b) RPG_INSTR_CONCAT2(a, b)
+
+#if RPG_INSTRUMENTATION
+#define RPG_TIME_SCOPE(phase) ::rpg::ScopedTimer RPG_INSTR_CONCAT(rpgScopedTimer, __LINE__)(::rpg::Phase::phase)
+#define RPG_COUNT(counter, n) ::rpg::Instrumentation::add(::rpg::Counter::counter, (n))
+#else
+#define RPG_TIME_SCOPE(phase) ((void)0)
+#define RPG_COUNT(counter, n) ((void)0)
+#endif
@@ -0,0 +1,92 @@
+#include "items.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace rpg {
+
+// ----------------------------
+// ItemRegistry
+// ----------------------------
+ItemRegistry& ItemRegistry::global() {
+    static ItemRegistry registry;
+    return registry;
+}
+
+ItemRegistry::ItemRegistry()
+    : count(0) {
+    for (auto& c : chunks) c.store(nullptr, std::memory_order_relaxed);
+    // id 0 = geen item, daarna de ingebouwde items op hun ItemKind.
+    intern("", ItemKind::None);
+    for (std::uint8_t k = 1; k < static_cast<std::uint8_t>(ItemKind::Count); ++k)
+        intern(itemName(static_cast<ItemKind>(k)), static_cast<ItemKind>(k));
+}
+
+ItemRegistry::~ItemRegistry() {
+    for (auto& c : chunks) delete[] c.load(std::memory_order_relaxed);
+}
+
+ItemId ItemRegistry::intern(std::string_view name) {
+    return intern(name, itemKind(name));
+}
+
+ItemId ItemRegistry::intern(std::string_view name, ItemKind kind) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(name);
+    if (it != index.end()) return it->second;
+
+    const std::uint32_t id = count.load(std::memory_order_relaxed);
+    if (id >= kMaxChunks * kChunkSize) throw std::length_error("Too many items in the ItemRegistry");
+
+    // Naam naar de arena; lange namen krijgen een eigen blok.
+    char* stored;
+    if (name.size() > kTextChunk) {
+        text.emplace_back(new char[name.size()]);
+        stored = text.back().get();
+    } else {
+        if (!textChunk || textUsed + name.size() > kTextChunk) {
+            text.emplace_back(new char[kTextChunk]);
+            textChunk = text.back().get();
+            textUsed = 0;
+        }
+        stored = textChunk + textUsed;
+        textUsed += name.size();
+    }
+    std::memcpy(stored, name.data(), name.size());
+
+    Entry* chunk = chunks[id >> kChunkBits].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Entry[kChunkSize];
+        chunks[id >> kChunkBits].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (kChunkSize - 1)] = Entry{std::string_view(stored, name.size()), kind};
+    index.emplace(std::string_view(stored, name.size()), id);
+    count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+ItemId ItemRegistry::find(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(name);
+    return it == index.end() || it->second == kNoItem ? kNoItem : it->second;
+}
+
+std::string_view ItemRegistry::name(ItemId id) const {
+    return id < size() ? entry(id).name : std::string_view();
+}
+
+ItemKind ItemRegistry::kind(ItemId id) const {
+    return id < size() ? entry(id).kind : ItemKind::None;
+}
+
+// ----------------------------
+// Inventory
+// ----------------------------
+void Inventory::erase(std::size_t i) {
+    if (i >= count) return;
+    std::copy(ids.begin() + static_cast<std::ptrdiff_t>(i) + 1, ids.begin() + count,
+              ids.begin() + static_cast<std::ptrdiff_t>(i));
+    --count;
+}
+
+} // namespace rpg
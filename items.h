@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Items met een effect
+// ----------------------------
+// Een item gebruiken kost de speler zijn actie van die beurt en haalt het
+// uit de inventory. Items met een andere naam hebben geen effect.
+enum class ItemKind : std::uint8_t {
+    None,
+    Sword,    // +kSwordBonus attack tot restore()
+    Shield,   // hasShield: halveert inkomende damage tot restore()
+    Potion,   // heal kPotionHeal
+    Count
+};
+
+constexpr std::size_t kItemKinds = static_cast<std::size_t>(ItemKind::Count) - 1;   // zonder None
+constexpr int kSwordBonus = 5;
+constexpr int kPotionHeal = 50;
+
+constexpr std::string_view itemName(ItemKind kind) {
+    switch (kind) {
+    case ItemKind::Sword: return "Sword";
+    case ItemKind::Shield: return "Shield";
+    case ItemKind::Potion: return "Potion";
+    default: return "";
+    }
+}
+
+constexpr ItemKind itemKind(std::string_view name) {
+    for (std::uint8_t k = 1; k < static_cast<std::uint8_t>(ItemKind::Count); ++k)
+        if (itemName(static_cast<ItemKind>(k)) == name) return static_cast<ItemKind>(k);
+    return ItemKind::None;
+}
+
+// ----------------------------
+// ItemRegistry: naam -> ItemId
+// ----------------------------
+// Eén registry per proces. De ingebouwde items hebben id == ItemKind
+// (Sword 1, Shield 2, Potion 3), 0 is "geen item". Namen staan in een
+// eigen arena en blijven geldig tot het einde van het programma.
+//
+// intern() en find() nemen een lock; name() en kind() lezen zonder lock
+// en zijn dus goedkoop vanuit showInventory() op elke thread, voor elk id
+// dat intern() al eens heeft teruggegeven.
+using ItemId = std::uint32_t;
+constexpr ItemId kNoItem = 0;
+
+constexpr ItemId builtinItem(ItemKind kind) { return static_cast<ItemId>(kind); }
+
+class ItemRegistry {
+public:
+    static ItemRegistry& global();
+
+    ~ItemRegistry();
+    ItemRegistry(const ItemRegistry&) = delete;
+    ItemRegistry& operator=(const ItemRegistry&) = delete;
+
+    // Een bestaande naam houdt zijn eerste ItemKind.
+    ItemId intern(std::string_view name);   // kind = itemKind(name)
+    ItemId intern(std::string_view name, ItemKind kind);
+    ItemId find(std::string_view name) const;   // kNoItem als onbekend
+
+    std::string_view name(ItemId id) const;
+    ItemKind kind(ItemId id) const;
+    inline std::size_t size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t kChunkBits = 10;
+    static constexpr std::size_t kChunkSize = std::size_t(1) << kChunkBits;
+    static constexpr std::size_t kMaxChunks = 4096;   // 4M items
+    static constexpr std::size_t kTextChunk = 64 * 1024;
+
+    struct Entry {
+        std::string_view name;
+        ItemKind kind = ItemKind::None;
+    };
+
+    ItemRegistry();
+    inline const Entry& entry(ItemId id) const {
+        return chunks[id >> kChunkBits].load(std::memory_order_acquire)[id & (kChunkSize - 1)];
+    }
+
+    std::array<std::atomic<Entry*>, kMaxChunks> chunks;
+    std::atomic<std::uint32_t> count;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string_view, ItemId> index;
+    std::vector<std::unique_ptr<char[]>> text;
+    char* textChunk = nullptr;
+    std::size_t textUsed = 0;
+};
+
+// ----------------------------
+// Inventory: vaste array van ids
+// ----------------------------
+class Inventory {
+public:
+    static constexpr std::size_t kCapacity = 16;
+
+    inline std::size_t size() const { return count; }
+    inline bool empty() const { return count == 0; }
+    inline bool full() const { return count == kCapacity; }
+    inline ItemId operator[](std::size_t i) const { return ids[i]; }
+    inline const ItemId* begin() const { return ids.data(); }
+    inline const ItemId* end() const { return ids.data() + count; }
+
+    // false als de inventory vol is of id kNoItem is.
+    inline bool add(ItemId id) {
+        if (id == kNoItem || full()) return false;
+        ids[count++] = id;
+        return true;
+    }
+    void erase(std::size_t i);
+    inline void clear() { count = 0; }
+
+private:
+    std::array<ItemId, kCapacity> ids{};
+    std::uint8_t count = 0;
+};
+
+} // namespace rpg
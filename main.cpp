@@ -1,19 +1,156 @@
 #include "rpg_classes.h"
+#include "auto_player.h"
+#include "battle_simulator.h"
+#include "catalog.h"
+#include "instrumentation.h"
+#include "outcome_solver.h"
 
 #ifndef UNIT_TEST
-int main() {
+// Gebruik: rpg_game --simulate [battles] [threads] [seed]
+//          rpg_game --record <seed> <battle> <file>
+//          rpg_game --replay <file>
+//          rpg_game --solve
+//          rpg_game --compile-catalog <catalog.txt> <catalog.bin>
+//          rpg_game [--catalog <file>] [--profile <file.json>] [--trace <file.json>]
+//                   [--auto <ms>] [--auto-iterations <n>]
+// De Qt app (appeindopdracht_CPP) neemt dezelfde opties.
+// --catalog speelt de campagne uit een catalogus (tekst of binair).
+// --auto laat de AutoPlayer de acties van de speler kiezen, met <ms> per beurt.
+// --auto-iterations begrenst het zoeken per beurt en thread; --auto 0 mag
+// alleen samen met een limiet.
+// --profile en --trace hebben alleen data in een RPG_INSTRUMENTATION build.
+static int runSimulation(int argc, char* argv[]) {
+    rpg::SimulationConfig config;
+    if (argc > 2) config.battles = std::stoull(argv[2]);
+    if (argc > 3) config.threads = static_cast<unsigned>(std::stoul(argv[3]));
+    if (argc > 4) config.seed = std::stoull(argv[4]);
+
+    rpg::Game game;
+    rpg::BattleSimulator simulator(game);
+    rpg::printReport(std::cout, simulator.run(config));
+    return 0;
+}
+
+static int recordReplay(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cerr << "Usage: --record <seed> <battle> <file>\n";
+        return 1;
+    }
+    rpg::SimulationConfig config;
+    config.seed = std::stoull(argv[2]);
+
+    rpg::Game game;
+    rpg::BattleSimulator simulator(game);
+    rpg::BattleReplay replay = simulator.record(config, std::stoull(argv[3]));
+    rpg::saveReplay(argv[4], replay);
+    std::cout << "Recorded battle #" << replay.battleIndex << ": "
+              << replay.decisions.size() << " decisions, "
+              << replay.expected.turns << " turns, "
+              << replay.expected.hpRemaining << " HP left\n";
+    return 0;
+}
+
+static int playReplay(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: --replay <file>\n";
+        return 1;
+    }
+    rpg::BattleReplay replay = rpg::loadReplay(argv[2]);
+
+    rpg::Game game;
+    rpg::BattleSimulator simulator(game);
+    rpg::CampaignResult result = simulator.replay(replay, true);
+
+    bool exact = result.won == replay.expected.won
+                 && result.hpRemaining == replay.expected.hpRemaining
+                 && result.turns == replay.expected.turns
+                 && result.heals == replay.expected.heals;
+    std::cout << "\nReplay " << (exact ? "matches" : "DIFFERS FROM") << " the recorded battle\n";
+    return exact ? 0 : 1;
+}
+
+static int solveExact() {
+    rpg::Game game;
+    rpg::OutcomeSolver solver;
+    rpg::printOutcome(std::cout, solver.solve(game));
+    return 0;
+}
+
+static int compileCatalog(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: --compile-catalog <catalog.txt> <catalog.bin>\n";
+        return 1;
+    }
+    rpg::Catalog catalog = rpg::loadCatalog(argv[2]);
+    rpg::saveCatalog(argv[3], catalog);
+    std::cout << catalog.monsterCount() << " monsters, " << catalog.itemCount() << " items -> " << argv[3] << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     try {
-        rpg::Game game;
+        if (argc > 1 && std::string(argv[1]) == "--simulate")
+            return runSimulation(argc, argv);
+        if (argc > 1 && std::string(argv[1]) == "--record")
+            return recordReplay(argc, argv);
+        if (argc > 1 && std::string(argv[1]) == "--replay")
+            return playReplay(argc, argv);
+        if (argc > 1 && std::string(argv[1]) == "--solve")
+            return solveExact();
+        if (argc > 1 && std::string(argv[1]) == "--compile-catalog")
+            return compileCatalog(argc, argv);
+
+        std::string profilePath, tracePath, catalogPath;
+        long autoBudget = -1;
+        std::uint64_t autoIterations = 0;
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--profile") profilePath = argv[i + 1];
+            else if (option == "--trace") tracePath = argv[i + 1];
+            else if (option == "--catalog") catalogPath = argv[i + 1];
+            else if (option == "--auto") autoBudget = std::stol(argv[i + 1]);
+            else if (option == "--auto-iterations") autoIterations = std::stoull(argv[i + 1]);
+        }
+        if (!tracePath.empty()) rpg::Instrumentation::enableTrace();
 
-        std::string sword = "Sword";
-        std::string shield = "Shield";
+        std::unique_ptr<rpg::Game> owned;
+        if (catalogPath.empty()) {
+            owned.reset(new rpg::Game());
+            if (rpg::Player* p = owned->getPlayer()) {
+                p->addItem("Sword");
+                p->addItem("Shield");
+            }
+        } else {
+            owned.reset(new rpg::Game(rpg::loadCatalog(catalogPath)));
+        }
+        rpg::Game& game = *owned;
 
-        if (rpg::Player* p = game.getPlayer()) {
-            p->addItem(sword);
-            p->addItem(shield);
+        rpg::AutoPlayerConfig autoConfig;
+        if (autoBudget >= 0) autoConfig.timeBudget = std::chrono::milliseconds(autoBudget);
+        autoConfig.maxIterations = autoIterations;
+        if (autoBudget == 0 && autoIterations == 0) {
+            std::cerr << "Usage: --auto 0 needs --auto-iterations <n>\n";
+            return 1;
         }
+        rpg::AutoPlayer autoPlayer(autoConfig);
+        if (autoBudget >= 0) game.setPolicy(&autoPlayer);
 
         game.start();
+
+        if (!profilePath.empty() || !tracePath.empty()) {
+            rpg::BattleLogger::flush();
+            rpg::InstrumentationSnapshot snapshot = rpg::Instrumentation::snapshot();
+            if (!profilePath.empty()) {
+                std::ofstream out(profilePath, std::ios::trunc);
+                if (!out) throw std::ios_base::failure("Cannot open " + profilePath);
+                rpg::Instrumentation::writeJson(out, snapshot);
+            }
+            if (!tracePath.empty()) {
+                std::ofstream out(tracePath, std::ios::trunc);
+                if (!out) throw std::ios_base::failure("Cannot open " + tracePath);
+                rpg::Instrumentation::writeChromeTrace(out, snapshot);
+            }
+        }
     } catch (const std::exception& e) {
         std::cerr << "Unexpected error: " << e.what() << "\n";
     } catch (...) {
@@ -0,0 +1,83 @@
+#include "mapped_file.h"
+#include <ios>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rpg {
+
+// ----------------------------
+// MappedFile
+// ----------------------------
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path)
+    : bytes(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) throw std::ios_base::failure("Cannot open " + path);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) {
+        CloseHandle(fileHandle);
+        throw std::ios_base::failure("Cannot stat " + path);
+    }
+    length = static_cast<std::size_t>(size.QuadPart);
+    if (length == 0) return;
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle)
+        bytes = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes) {
+        if (mappingHandle) CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::ios_base::failure("Cannot map " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+    : bytes(nullptr), length(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::ios_base::failure("Cannot open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::ios_base::failure("Cannot stat " + path);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length > 0) {
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::ios_base::failure("Cannot map " + path);
+        }
+        ::madvise(p, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const unsigned char*>(p);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) ::munmap(const_cast<unsigned char*>(bytes), length);
+}
+#endif
+
+} // namespace rpg
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace rpg {
+
+// ----------------------------
+// MappedFile: read-only memory map
+// ----------------------------
+// Windows (CreateFileMapping) en POSIX (mmap). Gooit std::ios_base::failure
+// als het bestand niet geopend of gemapt kan worden.
+class MappedFile {
+private:
+    const unsigned char* bytes;
+    std::size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline const unsigned char* data() const { return bytes; }
+    inline std::size_t size() const { return length; }
+};
+
+} // namespace rpg
@@ -0,0 +1,283 @@
+#include "outcome_solver.h"
+#include "damage_pipeline.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+
+namespace rpg {
+
+namespace {
+
+template<typename T>
+void appendBytes(std::string& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+double sum(const double* p, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; ++i) s += p[i];
+    return s;
+}
+
+} // namespace
+
+void printOutcome(std::ostream& os, const CampaignOutcome& outcome) {
+    os << std::fixed << std::setprecision(4)
+       << "Win probability: " << outcome.winProbability * 100.0 << "%\n"
+       << "Expected turns: " << outcome.expectedTurns << "\n"
+       << "Expected HP remaining: " << outcome.expectedHp << "\n";
+    for (auto& f : outcome.fights) {
+        os << "- " << f.monster << ": reached " << f.reachProbability * 100.0
+           << "%, won " << f.winProbability * 100.0 << "%, turns " << f.expectedTurns
+           << ", HP after " << f.expectedHpAfter << "\n";
+    }
+    os << "Turn distribution:\n";
+    for (std::size_t t = 0; t < outcome.turns.size(); ++t) {
+        if (outcome.turns[t] >= 0.00005) os << std::setw(4) << t << ": " << outcome.turns[t] * 100.0 << "%\n";
+    }
+}
+
+// ----------------------------
+// OutcomeSolver
+// ----------------------------
+OutcomeSolver::OutcomeSolver(const SolverConfig& cfg)
+    : config(cfg) {}
+
+void OutcomeSolver::clearCache() {
+    cache.clear();
+    hits = 0;
+}
+
+// Zelfde rolls als Character::strike: crit als uniformInt(1, 100) <= criticalChance,
+// daarna variatie uniformInt(8, 12), multiplier 1.
+std::vector<std::pair<int, double>> OutcomeSolver::damageOutcomes(const Character& attacker,
+                                                                  const Character& defender) {
+    const double crit = std::min<int>(attacker.criticalChance, 100) / 100.0;
+    std::map<int, double> outcomes;
+
+    // Eén tabel per (attacker, defender) paar, daarna alleen opzoeken.
+    DamageContext ctx;
+    ctx.raw = calculateDamage<int>(attacker.attackPower + attacker.attackBonus, 1);
+    const DamageTable table = StandardDamage::table(ctx);
+    for (int v = DamageTable::kMinVariation; v <= DamageTable::kMaxVariation; ++v) {
+        for (int c = 0; c < 2; ++c) {
+            const double p = (c ? crit : 1.0 - crit) / 5.0;
+            if (p <= 0.0) continue;
+            outcomes[table(v, c != 0, defender.hasShield)] += p;
+        }
+    }
+    return std::vector<std::pair<int, double>>(outcomes.begin(), outcomes.end());
+}
+
+const OutcomeSolver::FightResult& OutcomeSolver::fight(const Character& player, const Character& monster,
+                                                       const HpTurns& start) {
+    const auto hit = damageOutcomes(player, monster);
+    const auto taken = damageOutcomes(monster, player);
+    const int P = start.maxHp;
+    const int M = std::max(monster.health, 0);
+    const int K = start.width;
+
+    std::string key;
+    for (auto& o : hit) { appendBytes(key, o.first); appendBytes(key, o.second); }
+    appendBytes(key, -1);
+    for (auto& o : taken) { appendBytes(key, o.first); appendBytes(key, o.second); }
+    appendBytes(key, P);
+    appendBytes(key, M);
+    appendBytes(key, config.healThreshold);
+    appendBytes(key, config.healAmount);
+    appendBytes(key, start.tMin);
+    appendBytes(key, K);
+    key.append(reinterpret_cast<const char*>(start.mass.data()), start.mass.size() * sizeof(double));
+
+    auto found = cache.find(key);
+    if (found != cache.end()) {
+        ++hits;
+        return found->second;
+    }
+
+    FightResult r;
+    if (M == 0) {
+        // Monster is al dood: Game slaat de fight over.
+        r.survivors = start;
+        r.losses.assign(static_cast<std::size_t>(K), 0.0);
+        r.fightTurns.assign(1, sum(start.mass.data(), static_cast<int>(start.mass.size())));
+        return cache.emplace(std::move(key), std::move(r)).first->second;
+    }
+    if (hit.front().first <= 0)
+        throw std::domain_error(player.name + " can deal 0 damage to " + monster.name);
+
+    const int maxTurns = (M + hit.front().first - 1) / hit.front().first;
+    const int width = K + maxTurns - 1;
+    r.survivors.maxHp = P;
+    r.survivors.tMin = start.tMin + 1;
+    r.survivors.width = width;
+    r.survivors.mass.assign(static_cast<std::size_t>((P + 1) * width), 0.0);
+    r.losses.assign(static_cast<std::size_t>(width), 0.0);
+    r.fightTurns.assign(static_cast<std::size_t>(maxTurns + 1), 0.0);
+
+    // Tabel over (speler HP, monster HP) met per cel K kolommen: de beurten
+    // uit eerdere fights. Alleen cellen met massa staan in de live lijsten.
+    // Een beurt gaat in twee stappen (aanval speler, dan aanval monster plus
+    // heal), zodat elke cel 10 + 10 uitkomsten ziet in plaats van 10 x 10.
+    const std::size_t cells = static_cast<std::size_t>((P + 1) * (M + 1));
+    std::vector<double> cur(cells * K, 0.0), mid(cells * K, 0.0);
+    std::vector<std::size_t> live, midLive;
+    std::vector<char> marked(cells, 0);
+
+    auto addTo = [&](std::vector<double>& table, std::vector<std::size_t>& list, std::size_t cell,
+                     double w, const double* src) {
+        if (!marked[cell]) {
+            marked[cell] = 1;
+            list.push_back(cell);
+        }
+        double* dst = &table[cell * K];
+        for (int k = 0; k < K; ++k) dst[k] += w * src[k];
+    };
+
+    for (int p = 1; p <= P; ++p) {
+        const double* row = &start.mass[static_cast<std::size_t>(p * K)];
+        if (sum(row, K) == 0.0) continue;
+        const std::size_t cell = static_cast<std::size_t>(p * (M + 1) + M);
+        std::copy(row, row + K, &cur[cell * K]);
+        live.push_back(cell);
+    }
+
+    for (int t = 1; !live.empty(); ++t) {
+        // Aanval van de speler: monster HP omlaag of fight gewonnen.
+        for (std::size_t cell : live) {
+            const int p = static_cast<int>(cell / (M + 1));
+            const int m = static_cast<int>(cell % (M + 1));
+            double* src = &cur[cell * K];
+            const double total = sum(src, K);
+            for (auto& h : hit) {
+                if (h.first >= m) {
+                    // Monster verslagen na t aanvallen: T = Tstart + t.
+                    double* dst = &r.survivors.mass[static_cast<std::size_t>(p * width + t - 1)];
+                    for (int k = 0; k < K; ++k) dst[k] += h.second * src[k];
+                    r.fightTurns[t] += h.second * total;
+                } else {
+                    addTo(mid, midLive, cell - static_cast<std::size_t>(h.first), h.second, src);
+                }
+            }
+            std::fill(src, src + K, 0.0);
+        }
+        live.clear();
+        for (std::size_t cell : midLive) marked[cell] = 0;
+
+        // Aanval van het monster en de heal check.
+        for (std::size_t cell : midLive) {
+            const int p = static_cast<int>(cell / (M + 1));
+            const int m = static_cast<int>(cell % (M + 1));
+            double* src = &mid[cell * K];
+            for (auto& d : taken) {
+                int p2 = std::max(p - d.first, 0);
+                if (p2 < config.healThreshold) p2 = std::min(p2 + config.healAmount, P);
+                if (p2 <= 0) {
+                    double* dst = &r.losses[static_cast<std::size_t>(t - 1)];
+                    for (int k = 0; k < K; ++k) dst[k] += d.second * src[k];
+                    r.fightTurns[t] += d.second * sum(src, K);
+                } else {
+                    addTo(cur, live, static_cast<std::size_t>(p2 * (M + 1) + m), d.second, src);
+                }
+            }
+            std::fill(src, src + K, 0.0);
+        }
+        midLive.clear();
+        for (std::size_t cell : live) marked[cell] = 0;
+    }
+
+    // Lege kolommen aan het eind weghalen.
+    int used = width;
+    while (used > 1) {
+        bool empty = r.losses[static_cast<std::size_t>(used - 1)] == 0.0;
+        for (int p = 0; empty && p <= P; ++p)
+            empty = r.survivors.mass[static_cast<std::size_t>(p * width + used - 1)] == 0.0;
+        if (!empty) break;
+        --used;
+    }
+    if (used < width) {
+        std::vector<double> trimmed(static_cast<std::size_t>((P + 1) * used));
+        for (int p = 0; p <= P; ++p)
+            std::copy_n(&r.survivors.mass[static_cast<std::size_t>(p * width)], used,
+                        &trimmed[static_cast<std::size_t>(p * used)]);
+        r.survivors.mass = std::move(trimmed);
+        r.survivors.width = used;
+        r.losses.resize(static_cast<std::size_t>(used));
+    }
+
+    return cache.emplace(std::move(key), std::move(r)).first->second;
+}
+
+CampaignOutcome OutcomeSolver::solve(const Game& game) {
+    return solve(game.getRoster());
+}
+
+CampaignOutcome OutcomeSolver::solve(const Roster& roster) {
+    CampaignOutcome out;
+    if (roster.size() == 0) return out;
+    const Character& player = roster[0];
+    const int P = player.maxHealth;
+
+    HpTurns state;
+    state.maxHp = P;
+    state.mass.assign(static_cast<std::size_t>(P + 1), 0.0);
+    std::vector<double> losses;   // [T]
+    if (player.health > 0) state.mass[static_cast<std::size_t>(std::min(player.health, P))] = 1.0;
+    else losses.push_back(1.0);
+
+    for (std::size_t i = 1; i < roster.size(); ++i) {
+        FightOutcome fo;
+        fo.monster = roster[i].name;
+        fo.reachProbability = sum(state.mass.data(), static_cast<int>(state.mass.size()));
+        if (fo.reachProbability == 0.0) {
+            out.fights.push_back(std::move(fo));
+            continue;
+        }
+
+        const FightResult& r = fight(player, roster[i], state);
+        const int W = r.survivors.width;
+        double won = 0.0, hp = 0.0;
+        for (int p = 0; p <= P; ++p) {
+            const double m = sum(&r.survivors.mass[static_cast<std::size_t>(p * W)], W);
+            won += m;
+            hp += p * m;
+        }
+        fo.winProbability = won / fo.reachProbability;
+        fo.expectedHpAfter = won > 0.0 ? hp / won : 0.0;
+        fo.turns.resize(r.fightTurns.size());
+        for (std::size_t t = 0; t < r.fightTurns.size(); ++t) {
+            fo.turns[t] = r.fightTurns[t] / fo.reachProbability;
+            fo.expectedTurns += static_cast<double>(t) * fo.turns[t];
+        }
+
+        for (std::size_t k = 0; k < r.losses.size(); ++k) {
+            if (r.losses[k] == 0.0) continue;
+            const std::size_t T = static_cast<std::size_t>(r.survivors.tMin) + k;
+            if (losses.size() <= T) losses.resize(T + 1, 0.0);
+            losses[T] += r.losses[k];
+        }
+        state = r.survivors;
+        out.fights.push_back(std::move(fo));
+    }
+
+    out.hpRemaining.assign(static_cast<std::size_t>(P + 1), 0.0);
+    out.turns = losses;
+    for (std::size_t T = 0; T < losses.size(); ++T) out.hpRemaining[0] += losses[T];
+    for (int p = 0; p <= P; ++p) {
+        for (int k = 0; k < state.width; ++k) {
+            const double m = state.mass[static_cast<std::size_t>(p * state.width + k)];
+            if (m == 0.0) continue;
+            const std::size_t T = static_cast<std::size_t>(state.tMin + k);
+            if (out.turns.size() <= T) out.turns.resize(T + 1, 0.0);
+            out.turns[T] += m;
+            out.hpRemaining[static_cast<std::size_t>(p)] += m;
+            out.winProbability += m;
+        }
+    }
+    for (std::size_t T = 0; T < out.turns.size(); ++T) out.expectedTurns += static_cast<double>(T) * out.turns[T];
+    for (int p = 0; p <= P; ++p) out.expectedHp += p * out.hpRemaining[static_cast<std::size_t>(p)];
+    return out;
+}
+
+} // namespace rpg
@@ -0,0 +1,99 @@
+#pragma once
+#include "rpg_classes.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Solver configuratie
+// ----------------------------
+// Dezelfde heal regel als Game::start: heal healAmount zodra de speler
+// onder healThreshold zit (ook op 0 HP, dus de speler komt dan terug).
+struct SolverConfig {
+    int healThreshold = 40;
+    int healAmount = 20;
+};
+
+// ----------------------------
+// Resultaten
+// ----------------------------
+// "Turns" zijn aanvallen van de speler, zoals in SimulationStats.
+struct FightOutcome {
+    std::string monster;
+    double reachProbability = 0.0;   // kans dat de speler aan deze fight begint
+    double winProbability = 0.0;     // gegeven dat hij begint
+    std::vector<double> turns;       // turns[t], gegeven dat hij begint
+    double expectedTurns = 0.0;      // gegeven dat hij begint
+    double expectedHpAfter = 0.0;    // gegeven dat hij wint
+};
+
+struct CampaignOutcome {
+    double winProbability = 0.0;
+    std::vector<double> turns;         // totaal over de campagne
+    std::vector<double> hpRemaining;   // HP na de laatste fight, 0 = verloren
+    double expectedTurns = 0.0;
+    double expectedHp = 0.0;
+    std::vector<FightOutcome> fights;
+};
+
+void printOutcome(std::ostream& os, const CampaignOutcome& outcome);
+
+// ----------------------------
+// OutcomeSolver
+// ----------------------------
+// Exacte kansen voor een Game campagne in plaats van Monte Carlo. Binnen een
+// fight is de toestand (speler HP, monster HP); de kansmassa gaat per beurt
+// naar voren over een tabel op die twee, met per cel een vector over het
+// aantal beurten dat al in eerdere fights zat. Elke aanval heeft hooguit 10
+// uitkomsten (variatie 8..12 x crit), exact uniform dankzij Rng::uniformInt.
+//
+// Fights worden gecached op (stats van beide kanten, heal regel, verdeling
+// bij de start). Bij een sweep over het laatste monster worden de fights
+// ervoor dus niet opnieuw uitgerekend.
+//
+// Vereist dat de speler altijd minstens 1 damage doet (anders eindigt een
+// fight niet gegarandeerd); solve() gooit anders std::domain_error.
+class OutcomeSolver {
+public:
+    explicit OutcomeSolver(const SolverConfig& config = SolverConfig());
+
+    CampaignOutcome solve(const Game& game);
+    CampaignOutcome solve(const Roster& roster);   // [0] = speler
+
+    inline std::size_t cacheSize() const { return cache.size(); }
+    inline std::size_t cacheHits() const { return hits; }
+    void clearCache();
+
+    // Damage uitkomsten van één aanval met hun kans, gelijke waarden samengevoegd.
+    static std::vector<std::pair<int, double>> damageOutcomes(const Character& attacker,
+                                                              const Character& defender);
+
+private:
+    // Kansmassa over (HP, totaal aantal beurten); beurten vanaf tMin.
+    struct HpTurns {
+        int maxHp = 0;
+        int tMin = 0;
+        int width = 1;
+        std::vector<double> mass;   // [hp * width + (t - tMin)]
+    };
+
+    struct FightResult {
+        HpTurns survivors;              // speler heeft gewonnen
+        std::vector<double> losses;     // [t - survivors.tMin], speler dood
+        std::vector<double> fightTurns; // [t] aanvallen in deze fight
+    };
+
+    const FightResult& fight(const Character& player, const Character& monster, const HpTurns& start);
+
+    SolverConfig config;
+    std::unordered_map<std::string, FightResult> cache;
+    std::size_t hits = 0;
+};
+
+} // namespace rpg
@@ -0,0 +1,104 @@
+#include "output_sink.h"
+#include "battle_event_log.h"
+#include "rpg_classes.h"
+
+namespace rpg {
+
+// ----------------------------
+// Tekst formaat
+// ----------------------------
+void formatGameEvent(std::string& out, const GameEvent& e) {
+    switch (e.kind) {
+    case GameEventKind::RosterHeader:
+        out += "Monsters in the game:\n";
+        break;
+    case GameEventKind::RosterEntry:
+        out += "- ";
+        out += e.target->name;
+        out += " (HP: ";
+        out += std::to_string(e.value);
+        out += ")\n";
+        break;
+    case GameEventKind::BattleStart:
+        out += "\nNext battle: ";
+        out += e.target->name;
+        out += "\n";
+        break;
+    case GameEventKind::PlayerCharge:
+        out += e.actor->name;
+        out += " bravely attacks!\n";
+        break;
+    case GameEventKind::MonsterCharge:
+        out += e.actor->name;
+        out += " fiercely attacks!\n";
+        break;
+    case GameEventKind::Stunned:
+        out += e.actor->name;
+        out += " is stunned and cannot attack!\n";
+        break;
+    case GameEventKind::Attack:
+        formatAttack(out, e.actor->name, e.target->name, e.value,
+                     static_cast<std::uint8_t>((e.critical ? EventCritical : 0) | (e.blocked ? EventShield : 0)));
+        break;
+    case GameEventKind::Heal:
+        out += e.actor->name;
+        out += " heals for ";
+        out += std::to_string(e.value);
+        out += " HP!\n";
+        break;
+    case GameEventKind::UseItem:
+        out += e.actor->name;
+        out += " uses ";
+        out += ItemRegistry::global().name(static_cast<ItemId>(e.value));
+        out += "!\n";
+        break;
+    case GameEventKind::Status:
+        formatStatus(out, e.actor->name, e.actor->level, e.value, e.actor->maxHealth);
+        break;
+    case GameEventKind::TurnEnd:
+        out += "--------------------\n";
+        break;
+    case GameEventKind::Inventory:
+        out += "\n";
+        static_cast<const Player*>(e.actor)->appendInventory(out);
+        out += "\n";
+        break;
+    case GameEventKind::Winner:
+        out += "\nWinner: ";
+        out += e.actor ? e.actor->name : std::string("Monsters");
+        out += "\n";
+        break;
+    }
+}
+
+// ----------------------------
+// ConsoleSink
+// ----------------------------
+ConsoleSink::ConsoleSink(std::ostream& out, Mode m)
+    : os(out), mode(m) {
+    buffer.reserve(512);
+}
+
+ConsoleSink::~ConsoleSink() {
+    flush();
+}
+
+void ConsoleSink::emit(const GameEvent& e) {
+    formatGameEvent(buffer, e);
+    if (mode == Mode::PerEvent || e.kind == GameEventKind::TurnEnd || e.kind == GameEventKind::Winner)
+        flush();
+}
+
+void ConsoleSink::flush() {
+    if (buffer.empty()) return;
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+OutputSink& defaultOutput() {
+    // Per thread: attack() mag vanaf meerdere threads tegelijk lopen.
+    thread_local ConsoleSink console;
+    return console;
+}
+
+} // namespace rpg
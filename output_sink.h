@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace rpg {
+
+class Character;
+
+// ----------------------------
+// Game events
+// ----------------------------
+// Alles wat de game core aan de speler laat zien, als gestructureerd event.
+// actor en target zijn alleen geldig tijdens emit(); een sink die events
+// bewaart (bijv. voor de UI thread) kopieert wat hij nodig heeft.
+enum class GameEventKind : std::uint8_t {
+    RosterHeader,   // "Monsters in the game:"
+    RosterEntry,    // target = monster, value = HP
+    BattleStart,    // target = monster
+    PlayerCharge,   // actor valt aan (Player::attack)
+    MonsterCharge,  // actor valt aan (Monster::attack)
+    Stunned,        // actor slaat een beurt over
+    Attack,         // actor -> target, value = damage
+    Heal,           // actor, value = hoeveelheid
+    UseItem,        // actor is een Player, value = ItemId
+    Status,         // actor, value = HP
+    TurnEnd,
+    Inventory,      // actor is een Player
+    Winner          // actor = winnaar, nullptr = de monsters
+};
+
+struct GameEvent {
+    GameEventKind kind = GameEventKind::TurnEnd;
+    const Character* actor = nullptr;
+    const Character* target = nullptr;
+    int value = 0;
+    bool critical = false;
+    bool blocked = false;
+};
+
+// De console tekst van een event, byte-voor-byte gelijk aan de oude output.
+void formatGameEvent(std::string& out, const GameEvent& e);
+
+// ----------------------------
+// OutputSink
+// ----------------------------
+// De core bouwt alleen een event als enabled() waar is; met de NullSink
+// wordt er dus niets geformatteerd of gekopieerd.
+class OutputSink {
+private:
+    const bool active;
+
+protected:
+    explicit OutputSink(bool enabled = true) : active(enabled) {}
+
+public:
+    virtual ~OutputSink() {}
+
+    inline bool enabled() const { return active; }
+    virtual void emit(const GameEvent& e) = 0;
+    virtual void flush() {}
+};
+
+class NullSink : public OutputSink {
+public:
+    NullSink() : OutputSink(false) {}
+    void emit(const GameEvent&) override {}
+};
+
+// Formatteert in één hergebruikte buffer. PerEvent schrijft elk event
+// meteen weg (het oude gedrag); PerTurn schrijft één keer per beurt, bij
+// het einde van een battle en bij de winnaar.
+class ConsoleSink : public OutputSink {
+public:
+    enum class Mode { PerEvent, PerTurn };
+
+    explicit ConsoleSink(std::ostream& os = std::cout, Mode mode = Mode::PerEvent);
+    ~ConsoleSink() override;
+
+    void emit(const GameEvent& e) override;
+    void flush() override;
+
+private:
+    std::ostream& os;
+    const Mode mode;
+    std::string buffer;
+};
+
+// Geeft elk event door aan een callback, bijv. de Qt UI die het via een
+// queued signal naar de GUI thread stuurt.
+class CallbackSink : public OutputSink {
+public:
+    using Callback = std::function<void(const GameEvent&)>;
+
+    explicit CallbackSink(Callback cb) : callback(std::move(cb)) {}
+    void emit(const GameEvent& e) override { callback(e); }
+
+private:
+    Callback callback;
+};
+
+// De sink voor combatants zonder eigen sink: ConsoleSink in PerEvent mode,
+// één per thread.
+OutputSink& defaultOutput();
+
+} // namespace rpg
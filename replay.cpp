@@ -0,0 +1,98 @@
+#include "replay.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace rpg {
+
+namespace {
+
+constexpr char kReplayMagic[4] = {'R', 'P', 'G', 'R'};
+constexpr std::uint8_t kReplayVersion = 1;
+
+void writeLE(std::ostream& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+std::uint64_t readLE(std::istream& in, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        int c = in.get();
+        if (c == EOF) throw std::runtime_error("Replay file is truncated");
+        value |= static_cast<std::uint64_t>(c & 0xFF) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+// ----------------------------
+// Replay bestanden
+// ----------------------------
+void saveReplay(const std::string& path, const BattleReplay& replay) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::ios_base::failure("Cannot open " + path);
+
+    out.write(kReplayMagic, sizeof(kReplayMagic));
+    writeLE(out, kReplayVersion, 1);
+    writeLE(out, replay.seed, 8);
+    writeLE(out, replay.battleIndex, 8);
+    writeLE(out, static_cast<std::uint32_t>(replay.healAmount), 4);
+    writeLE(out, replay.expected.won ? 1 : 0, 1);
+    writeLE(out, static_cast<std::uint32_t>(replay.expected.hpRemaining), 4);
+    writeLE(out, replay.expected.turns, 4);
+    writeLE(out, replay.expected.heals, 4);
+    writeLE(out, replay.decisions.size(), 4);
+
+    std::uint8_t bits = 0;
+    for (std::size_t i = 0; i < replay.decisions.size(); ++i) {
+        if (replay.decisions[i] == Decision::Heal) bits |= static_cast<std::uint8_t>(1u << (i % 8));
+        if (i % 8 == 7) {
+            out.put(static_cast<char>(bits));
+            bits = 0;
+        }
+    }
+    if (replay.decisions.size() % 8) out.put(static_cast<char>(bits));
+
+    if (!out) throw std::ios_base::failure("Cannot write " + path);
+}
+
+BattleReplay loadReplay(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::ios_base::failure("Cannot open " + path);
+
+    char magic[4];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + 4, kReplayMagic))
+        throw std::runtime_error(path + " is not a replay file");
+    if (readLE(in, 1) != kReplayVersion)
+        throw std::runtime_error(path + " has an unsupported replay version");
+
+    BattleReplay replay;
+    replay.seed = readLE(in, 8);
+    replay.battleIndex = readLE(in, 8);
+    replay.healAmount = static_cast<int>(static_cast<std::uint32_t>(readLE(in, 4)));
+    replay.expected.won = readLE(in, 1) != 0;
+    replay.expected.hpRemaining = static_cast<int>(static_cast<std::uint32_t>(readLE(in, 4)));
+    replay.expected.turns = static_cast<std::uint32_t>(readLE(in, 4));
+    replay.expected.heals = static_cast<std::uint32_t>(readLE(in, 4));
+
+    // Eén bit per beslissing: count mag niet meer vragen dan er nog in het
+    // bestand staat, anders reserveert een kapot bestand gigabytes.
+    const std::size_t count = static_cast<std::size_t>(readLE(in, 4));
+    const std::streampos payload = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::uint64_t remaining = static_cast<std::uint64_t>(in.tellg() - payload);
+    in.seekg(payload);
+    if ((static_cast<std::uint64_t>(count) + 7) / 8 > remaining)
+        throw std::runtime_error("Replay file is truncated");
+    replay.decisions.reserve(count);
+    std::uint8_t bits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 8 == 0) bits = static_cast<std::uint8_t>(readLE(in, 1));
+        replay.decisions.push_back((bits >> (i % 8)) & 1u ? Decision::Heal : Decision::Continue);
+    }
+    return replay;
+}
+
+} // namespace rpg
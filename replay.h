@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Beslissingen van de speler
+// ----------------------------
+// Na elke aanval van een monster beslist de speler of hij healt
+// (Game::start: heal als HP < 40). Alle andere randomness komt uit de RNG.
+enum class Decision : std::uint8_t {
+    Continue = 0,
+    Heal = 1
+};
+
+struct CampaignResult {
+    bool won = false;
+    int hpRemaining = 0;
+    std::uint32_t turns = 0;
+    std::uint32_t heals = 0;
+};
+
+// ----------------------------
+// Replay: seed + beslissingen
+// ----------------------------
+// Samen met CounterRng::forBattle(seed, battleIndex) is dit genoeg om een
+// campagne bit-exact opnieuw te spelen. expected dient als controle.
+struct BattleReplay {
+    std::uint64_t seed = 0;
+    std::uint64_t battleIndex = 0;
+    int healAmount = 20;
+    std::vector<Decision> decisions;
+    CampaignResult expected;
+};
+
+// Bestandsformaat (little-endian): "RPGR", versie, seed, battle index,
+// heal amount, verwacht resultaat, aantal beslissingen en daarna één bit
+// per beslissing.
+void saveReplay(const std::string& path, const BattleReplay& replay);
+BattleReplay loadReplay(const std::string& path);
+
+} // namespace rpg
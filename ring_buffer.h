@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace rpg {
+
+// ----------------------------
+// Lock-free bounded ring buffer
+// ----------------------------
+// Multi-producer / multi-consumer queue met een vaste capaciteit
+// (sequence-per-slot schema van Dmitry Vyukov). Producers en consumers
+// claimen een slot met een enkele compare-exchange; er wordt nooit gealloceerd
+// na de constructor.
+template<typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(std::size_t capacity)
+        : mask(roundUpToPowerOfTwo(capacity) - 1),
+        cells(new Cell[mask + 1]) {
+        for (std::size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    inline std::size_t capacity() const { return mask + 1; }
+
+    // Benadering: alleen bruikbaar als hint (bv. om de consumer te wekken).
+    inline std::size_t approxSize() const {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t h = head.load(std::memory_order_relaxed);
+        return t >= h ? t - h : 0;
+    }
+
+    // Verplaatst value alleen als er plaats is; bij false blijft value intact.
+    bool tryPush(T&& value) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // buffer vol
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // buffer leeg
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> tail{0};
+    alignas(64) std::atomic<std::size_t> head{0};
+};
+
+} // namespace rpg
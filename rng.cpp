@@ -0,0 +1,87 @@
+#include "rng.h"
+
+namespace rpg {
+
+// ----------------------------
+// Rng
+// ----------------------------
+int Rng::uniformInt(int lo, int hi) {
+    const std::uint32_t range = static_cast<std::uint32_t>(hi - lo) + 1u;
+    if (range == 0) return static_cast<int>(next()); // volledige 32-bit range
+
+    std::uint64_t m = static_cast<std::uint64_t>(next()) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+    if (low < range) {
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = static_cast<std::uint64_t>(next()) * range;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+    return lo + static_cast<int>(m >> 32);
+}
+
+// ----------------------------
+// CounterRng
+// ----------------------------
+namespace {
+
+constexpr std::uint32_t kPhiloxM0 = 0xD2511F53u;
+constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57u;
+constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9u;
+constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+    const std::uint64_t p = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(p >> 32);
+    lo = static_cast<std::uint32_t>(p);
+}
+
+} // namespace
+
+CounterRng::CounterRng(std::uint64_t seed, std::uint64_t s)
+    : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+    stream(s), position(0), block{} {}
+
+void CounterRng::generate(std::uint64_t blockIndex) {
+    std::uint32_t c0 = static_cast<std::uint32_t>(blockIndex);
+    std::uint32_t c1 = static_cast<std::uint32_t>(blockIndex >> 32);
+    std::uint32_t c2 = static_cast<std::uint32_t>(stream);
+    std::uint32_t c3 = static_cast<std::uint32_t>(stream >> 32);
+    std::uint32_t k0 = key[0];
+    std::uint32_t k1 = key[1];
+
+    for (int round = 0; round < 10; ++round) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(kPhiloxM0, c0, hi0, lo0);
+        mulhilo(kPhiloxM1, c2, hi1, lo1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += kPhiloxW0;
+        k1 += kPhiloxW1;
+    }
+    block = {c0, c1, c2, c3};
+}
+
+std::uint32_t CounterRng::next() {
+    const unsigned lane = static_cast<unsigned>(position & 3u);
+    if (lane == 0) generate(position >> 2);
+    ++position;
+    return block[lane];
+}
+
+void CounterRng::seek(std::uint64_t pos) {
+    position = pos;
+    if (pos & 3u) generate(pos >> 2);
+}
+
+CounterRng CounterRng::split(std::uint64_t newStream) const {
+    CounterRng copy(*this);
+    copy.stream = newStream;
+    copy.position = 0;
+    return copy;
+}
+
+} // namespace rpg
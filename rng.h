@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace rpg {
+
+// ----------------------------
+// Rng interface
+// ----------------------------
+// Alle randomness in de combat code loopt via deze interface, zodat een
+// battle met een vaste generator exact herhaald kan worden. Voldoet ook aan
+// UniformRandomBitGenerator voor gebruik met <random>.
+class Rng {
+public:
+    using result_type = std::uint32_t;
+
+    virtual ~Rng() {}
+    virtual std::uint32_t next() = 0;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+    inline result_type operator()() { return next(); }
+
+    // Uniform in [lo, hi]; platform-onafhankelijk (Lemire), in tegenstelling
+    // tot std::uniform_int_distribution.
+    int uniformInt(int lo, int hi);
+};
+
+// ----------------------------
+// CounterRng: Philox4x32-10
+// ----------------------------
+// Counter-based generator: de output op positie n van stream s is een pure
+// functie van (seed, s, n). Elke battle krijgt zijn eigen stream, dus een
+// battle is afleidbaar uit (seed, battle index) en seek() is O(1).
+class CounterRng : public Rng {
+private:
+    std::array<std::uint32_t, 2> key;
+    std::uint64_t stream;
+    std::uint64_t position;              // aantal getrokken waarden
+    std::array<std::uint32_t, 4> block;  // output van het huidige counter block
+
+    void generate(std::uint64_t blockIndex);
+
+public:
+    explicit CounterRng(std::uint64_t seed, std::uint64_t stream = 0);
+
+    std::uint32_t next() override;
+
+    void seek(std::uint64_t pos);
+    inline std::uint64_t tell() const { return position; }
+    inline std::uint64_t getStream() const { return stream; }
+    CounterRng split(std::uint64_t newStream) const;
+
+    static CounterRng forBattle(std::uint64_t seed, std::uint64_t battleIndex) {
+        return CounterRng(seed, battleIndex);
+    }
+};
+
+} // namespace rpg
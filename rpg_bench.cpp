@@ -0,0 +1,227 @@
+#include "rpg_classes.h"
+#include "alloc_counter.h"
+#include "battle_simulator.h"
+#include "catalog.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace rpg;
+
+// ----------------------------
+// Benchmark harness
+// ----------------------------
+// Elke benchmark draait in batches tot minTime verstreken is. Console output
+// gaat tijdens het meten naar een null buffer: het formatteren wordt gemeten,
+// het scrollen van de terminal niet.
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+struct BenchResult {
+    std::string name;
+    std::string unit;          // wat één op is, voor de throughput
+    std::uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double opsPerSec = 0.0;
+};
+
+struct BenchOptions {
+    double minTime = 0.3;
+    std::string filter;
+    std::string jsonPath;
+};
+
+using Clock = std::chrono::steady_clock;
+
+BenchResult measure(const std::string& name, const std::string& unit, double minTime,
+                    const std::function<void()>& op) {
+    for (int i = 0; i < 3; ++i) op(); // warm-up
+
+    std::uint64_t iterations = 0;
+    std::uint64_t batch = 1;
+    const std::uint64_t allocsBefore = allocationCount();
+    const auto start = Clock::now();
+    double elapsed = 0.0;
+    while (elapsed < minTime) {
+        for (std::uint64_t i = 0; i < batch; ++i) op();
+        iterations += batch;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (batch < (1u << 20)) batch *= 2;
+    }
+    const std::uint64_t allocs = allocationCount() - allocsBefore;
+
+    BenchResult r;
+    r.name = name;
+    r.unit = unit;
+    r.iterations = iterations;
+    r.nsPerOp = elapsed * 1e9 / static_cast<double>(iterations);
+    r.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(iterations);
+    r.opsPerSec = static_cast<double>(iterations) / elapsed;
+    return r;
+}
+
+void writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) throw std::ios_base::failure("Cannot open " + path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit
+            << "\", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp
+            << ", \"allocs_per_op\": " << r.allocsPerOp
+            << ", \"ops_per_sec\": " << r.opsPerSec << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+// ----------------------------
+// Benchmarks
+// ----------------------------
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) options.jsonPath = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) options.minTime = std::stod(argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+        else {
+            std::cerr << "Usage: rpg_bench [--json file] [--min-time seconds] [--filter text]\n";
+            return 1;
+        }
+    }
+
+    LoggerConfig logConfig;
+    logConfig.path = "rpg_bench_log.txt";
+    std::remove(logConfig.path.c_str());
+    BattleLogger::configure(logConfig);
+
+    NullBuffer nullBuffer;
+    std::streambuf* console = std::cout.rdbuf();
+    std::vector<BenchResult> results;
+
+    auto run = [&](const std::string& name, const std::string& unit, const std::function<void()>& op) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+        std::cout.rdbuf(&nullBuffer);
+        BenchResult r = measure(name, unit, options.minTime, op);
+        std::cout.rdbuf(console);
+        std::cout << std::left << std::setw(34) << r.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << r.nsPerOp << " ns/op"
+                  << std::setprecision(2) << std::setw(10) << r.allocsPerOp << " allocs/op"
+                  << std::setprecision(0) << std::setw(14) << r.opsPerSec << " " << r.unit << "/s\n";
+        results.push_back(r);
+    };
+
+    CounterRng rng(12345);
+    Player hero("Hero", 100, 18, 1, 20);
+    Monster dummy("Dummy", 1000000000, 12, 1, 10);
+    hero.setRng(&rng);
+
+    run("character_strike", "attacks", [&] {
+        hero.strike(dummy, 1, rng);
+        if (!dummy.isAlive()) dummy.restore();
+    });
+
+    run("character_attack_output", "attacks", [&] {
+        hero.attack(dummy);
+        if (!dummy.isAlive()) dummy.restore();
+    });
+
+    run("battle_logger_log_status", "lines", [&] {
+        BattleLogger::logStatus(dummy);
+    });
+
+    Player packed("Hero", 100, 18, 1, 20);
+    packed.addItem("Sword");
+    packed.addItem("Shield");
+    packed.addItem("Potion");
+    run("player_show_inventory", "calls", [&] {
+        std::string s = packed.showInventory();
+        if (s.empty()) std::abort();
+    });
+
+    run("game_construct_destroy", "games", [&] {
+        Game game;
+        if (!game.getPlayer()) std::abort();
+    });
+
+    std::uint64_t battleIndex = 0;
+    run("game_start_full", "battles", [&] {
+        Game game;
+        CounterRng battleRng = CounterRng::forBattle(1, battleIndex++);
+        game.setRng(&battleRng);
+        game.start();
+    });
+
+    NullSink headless;
+    run("game_start_null_sink", "battles", [&] {
+        Game game;
+        CounterRng battleRng = CounterRng::forBattle(1, battleIndex++);
+        game.setRng(&battleRng);
+        game.setOutput(&headless);
+        game.start();
+    });
+
+    {
+        Game game;
+        BattleSimulator simulator(game);
+        SimulationConfig config;
+        config.battles = 10000;
+        config.threads = 1;
+        run("simulator_10k_campaigns_1_thread", "runs", [&] {
+            simulator.run(config);
+        });
+    }
+
+    {
+        // Catalogus met 100k monsters en 100k items: tekst parsen tegen de
+        // binaire vorm mappen en op naam zoeken.
+        std::ostringstream text;
+        for (int i = 0; i < 100000; ++i) {
+            text << "monster Monster" << i << " " << 50 + i % 200 << " " << 5 + i % 30 << " " << 1 + i % 20 << " " << i % 40 << "\n";
+            text << "item Item" << i << (i % 4 == 1 ? " Sword" : "") << "\n";
+        }
+        text << "campaign Monster1 Monster2 Monster3\ninventory Item1 Item2\n";
+        const std::string source = text.str();
+        const std::string binaryPath = "rpg_bench_catalog.bin";
+        saveCatalog(binaryPath, [&] { std::istringstream in(source); return parseCatalog(in); }());
+
+        run("catalog_parse_text_100k", "catalogs", [&] {
+            std::istringstream in(source);
+            Catalog catalog = parseCatalog(in);
+            if (catalog.monsterCount() != 100000) std::abort();
+        });
+        run("catalog_map_binary_100k", "catalogs", [&] {
+            Catalog catalog = loadCatalog(binaryPath);
+            if (catalog.findMonster("Monster99999") != 99999) std::abort();
+        });
+        Catalog mapped = loadCatalog(binaryPath);
+        run("game_construct_from_catalog", "games", [&] {
+            Game game(mapped);
+            if (!game.getPlayer()) std::abort();
+        });
+        std::remove(binaryPath.c_str());
+    }
+
+    BattleLogger::shutdown();
+    std::remove(logConfig.path.c_str());
+
+    if (!options.jsonPath.empty()) writeJson(options.jsonPath, results);
+    return 0;
+}
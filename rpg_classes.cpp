@@ -1,76 +1,85 @@
 #include "rpg_classes.h"
+#include "catalog.h"
+#include "damage_pipeline.h"
+#include "instrumentation.h"
 #include <iostream>
-#include <fstream>
 #include <random>
 #include <ctime>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
 
 namespace rpg {
 
 // ----------------------------
 // Character
 // ----------------------------
-void Character::attack(Character& target, int multiplier) {
+void Character::restore() {
+    health = maxHealth;
+    attackBonus = 0;
+    isStunned = false;
+    hasShield = false;
+    criticalActive = false;
+    isPoisoned = false;
+}
+
+AttackResult Character::strike(Character& target, int multiplier, Rng& random) {
+    AttackResult result;
     if (isStunned) {
-        std::cout << name << " is stunned and cannot attack!\n";
         isStunned = false;
-        return;
+        result.stunned = true;
+        RPG_COUNT(StunnedTurns, 1);
+        return result;
     }
 
-    static std::mt19937 rng(static_cast<unsigned>(time(nullptr)));
-    std::uniform_int_distribution<int> variation(8, 12);
-    std::uniform_int_distribution<int> critRoll(1, 100);
-
-    bool criticalHit = critRoll(rng) <= criticalChance;
+    bool criticalHit = random.uniformInt(1, 100) <= criticalChance;
     criticalActive = criticalHit;
 
-    auto computeDamage = [&](int base, double mod) -> int {
-        int dmg = static_cast<int>(base * mod);
-        if (target.hasShield) dmg /= 2;
-        return dmg;
-    };
-
-    int rawDamage = calculateDamage<int>(attackPower, multiplier);
-    int damage = computeDamage(rawDamage, variation(rng)/10.0 * (criticalHit ? 2.0 : 1.0));
+    DamageContext ctx;
+    ctx.raw = calculateDamage<int>(attackPower + attackBonus, multiplier);
+    ctx.variation = random.uniformInt(8, 12);
+    ctx.critical = criticalHit;
+    ctx.shielded = target.hasShield;
+    int damage = StandardDamage::apply(ctx);
 
     target.health -= damage;
     if (target.health < 0) target.health = 0;
 
-    std::cout << name << " attacks " << target.getName()
-              << " for " << damage << " damage";
-    if (criticalHit) std::cout << " (CRITICAL HIT!)";
-    if (target.hasShield) std::cout << " [Blocked by shield]";
-    std::cout << "\n";
-
-    try {
-        std::ofstream logfile("battle_log.txt", std::ios::app);
-        if (!logfile) throw std::ios_base::failure("Cannot open battle_log.txt");
-        logfile << name << " attacks " << target.getName()
-                << " for " << damage << " damage";
-        if (criticalHit) logfile << " (CRITICAL HIT!)";
-        if (target.hasShield) logfile << " [Blocked by shield]";
-        logfile << "\n";
-    } catch (const std::ios_base::failure& e) {
-        std::cerr << "File I/O error: " << e.what() << "\n";
-    }
+    result.damage = damage;
+    result.critical = criticalHit;
+    result.blocked = target.hasShield;
+    RPG_COUNT(Attacks, 1);
+    RPG_COUNT(CriticalHits, criticalHit);
+    RPG_COUNT(ShieldHits, target.hasShield);
+    return result;
 }
 
-// ----------------------------
-// BattleLogger
-// ----------------------------
-void BattleLogger::logStatus(const Character& c) {
-    std::cout << "[LOG] " << c.getName()
-    << " (Lv " << static_cast<int>(c.getLevel()) << ") "
-    << "HP: " << c.getHealth() << "/" << c.getMaxHealth() << "\n";
+void Character::attack(Character& target, int multiplier) {
+    RPG_TIME_SCOPE(Attack);
+    thread_local CounterRng fallback(static_cast<std::uint64_t>(time(nullptr)),
+                                     std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    AttackResult hit;
+    {
+        RPG_TIME_SCOPE(Damage);
+        hit = strike(target, multiplier, rng ? *rng : fallback);
+    }
+    OutputSink& sink = out();
+    if (hit.stunned) {
+        if (sink.enabled()) sink.emit({GameEventKind::Stunned, this});
+        return;
+    }
 
-    try {
-        std::ofstream logfile("battle_log.txt", std::ios::app);
-        if (!logfile) throw std::ios_base::failure("Cannot open battle_log.txt");
-        logfile << "[LOG] " << c.getName()
-                << " (Lv " << static_cast<int>(c.getLevel()) << ") "
-                << "HP: " << c.getHealth() << "/" << c.getMaxHealth() << "\n";
-    } catch (const std::ios_base::failure& e) {
-        std::cerr << "File I/O error: " << e.what() << "\n";
+    if (sink.enabled()) {
+        RPG_TIME_SCOPE(Output);
+        GameEvent e{GameEventKind::Attack, this, &target, hit.damage};
+        e.critical = hit.critical;
+        e.blocked = hit.blocked;
+        sink.emit(e);
     }
+
+    BattleLogger::logAttack(*this, target, hit);
 }
 
 // ----------------------------
@@ -81,26 +90,83 @@ Player::Player(const std::string& n, int h, int a, unsigned char lvl, unsigned c
     : Character(n, h, a, lvl, crit), inventory() {}
 
 void Player::attack(Character& target, int multiplier) {
-    std::cout << name << " bravely attacks!\n";
+    OutputSink& sink = out();
+    if (sink.enabled()) sink.emit({GameEventKind::PlayerCharge, this});
     Character::attack(target, multiplier);
 }
 
 void Player::heal(int amount) {
+    RPG_TIME_SCOPE(Heal);
+    applyHeal(amount);
+    OutputSink& sink = out();
+    if (sink.enabled()) sink.emit({GameEventKind::Heal, this, nullptr, amount});
+}
+
+void Player::applyHeal(int amount) {
+    RPG_COUNT(Heals, 1);
     health += amount;
     if (health > maxHealth) health = maxHealth;
-    std::cout << name << " heals for " << amount << " HP!\n";
 }
 
-void Player::addItem(const std::string& item) {
-    inventory.push_back(item);
+void Player::restore() {
+    Character::restore();
+    inventory = starting;
+}
+
+bool Player::addItem(std::string_view item) {
+    return !inventory.full() && addItem(ItemRegistry::global().intern(item));
+}
+
+bool Player::addItem(ItemId item) {
+    if (!inventory.add(item)) return false;
+    starting.add(item);
+    return true;
+}
+
+bool Player::useItem(ItemKind kind) {
+    const ItemRegistry& items = ItemRegistry::global();
+    std::size_t slot = 0;
+    while (slot < inventory.size() && items.kind(inventory[slot]) != kind) ++slot;
+    if (kind == ItemKind::None || slot == inventory.size()) return false;
+
+    switch (kind) {
+    case ItemKind::Sword:
+        attackBonus += kSwordBonus;
+        break;
+    case ItemKind::Shield:
+        hasShield = true;
+        break;
+    case ItemKind::Potion:
+        applyHeal(kPotionHeal);
+        break;
+    default:
+        break;
+    }
+    OutputSink& sink = out();
+    if (sink.enabled()) sink.emit({GameEventKind::UseItem, this, nullptr, static_cast<int>(inventory[slot])});
+    inventory.erase(slot);
+    return true;
 }
 
 std::string Player::showInventory() const {
-    if (inventory.empty()) return name + "'s inventory is empty.";
-    std::stringstream ss;
-    ss << name << "'s Inventory: ";
-    for (auto& item : inventory) ss << item << " ";
-    return ss.str();
+    std::string out;
+    out.reserve(name.size() + 24 + inventory.size() * 8);
+    appendInventory(out);
+    return out;
+}
+
+void Player::appendInventory(std::string& out) const {
+    out += name;
+    if (inventory.empty()) {
+        out += "'s inventory is empty.";
+        return;
+    }
+    out += "'s Inventory: ";
+    const ItemRegistry& items = ItemRegistry::global();
+    for (ItemId item : inventory) {
+        out += items.name(item);
+        out += ' ';
+    }
 }
 
 // ----------------------------
@@ -111,74 +177,367 @@ Monster::Monster(const std::string& n, int h, int a, unsigned char lvl, unsigned
     : Character(n, h, a, lvl, crit) {}
 
 void Monster::attack(Character& target, int multiplier) {
-    std::cout << name << " fiercely attacks!\n";
+    OutputSink& sink = out();
+    if (sink.enabled()) sink.emit({GameEventKind::MonsterCharge, this});
     Character::attack(target, multiplier);
 }
 
+// ----------------------------
+// Roster
+// ----------------------------
+Roster::Roster()
+    : arena(buffer, sizeof(buffer)), members(&arena) {}
+
+Roster::Roster(const Roster& other)
+    : arena(buffer, sizeof(buffer)), members(other.members, &arena) {}
+
+void Roster::reserve(std::size_t n) {
+    members.reserve(n);
+}
+
+Character& Roster::operator[](std::size_t i) {
+    return std::visit([](auto& c) -> Character& { return c; }, members[i]);
+}
+
+const Character& Roster::operator[](std::size_t i) const {
+    return std::visit([](auto& c) -> const Character& { return c; }, members[i]);
+}
+
+bool Roster::canHeal(std::size_t i) const {
+    return std::visit([](auto& c) { return CanHeal<std::decay_t<decltype(c)>>::value; }, members[i]);
+}
+
+void Roster::attack(std::size_t i, Character& target, int multiplier) {
+    std::visit([&](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        c.T::attack(target, multiplier);
+    }, members[i]);
+}
+
+bool Roster::heal(std::size_t i, int amount) {
+    return std::visit([&](auto& c) {
+        if constexpr (CanHeal<std::decay_t<decltype(c)>>::value) {
+            c.heal(amount);
+            return true;
+        } else {
+            return false;
+        }
+    }, members[i]);
+}
+
+bool Roster::applyHeal(std::size_t i, int amount) {
+    return std::visit([&](auto& c) {
+        if constexpr (CanHeal<std::decay_t<decltype(c)>>::value) {
+            c.applyHeal(amount);
+            return true;
+        } else {
+            return false;
+        }
+    }, members[i]);
+}
+
+void Roster::setRng(Rng* rng) {
+    for (std::size_t i = 0; i < members.size(); ++i) (*this)[i].setRng(rng);
+}
+
+void Roster::setOutput(OutputSink* sink) {
+    for (std::size_t i = 0; i < members.size(); ++i) (*this)[i].setOutput(sink);
+}
+
+void Roster::reset() {
+    for (auto& member : members) std::visit([](auto& c) { c.restore(); }, member);
+}
+
 // ----------------------------
 // Game
 // ----------------------------
 Game::Game() {
-    player = new Player();
-    monsters.push_back(new Monster("Goblin", 80, 12, 1, 10));
-    monsters.push_back(new Monster("Orc", 120, 18, 2, 15));
-    monsters.push_back(new Monster("Troll", 150, 20, 3, 5));
+    roster.reserve(4);
+    roster.add<Player>();
+    roster.add<Monster>("Goblin", 80, 12, 1, 10);
+    roster.add<Monster>("Orc", 120, 18, 2, 15);
+    roster.add<Monster>("Troll", 150, 20, 3, 5);
+}
+
+Game::Game(const Catalog& catalog) {
+    const std::size_t monsters = catalog.campaignSize() ? catalog.campaignSize() : catalog.monsterCount();
+    roster.reserve(monsters + 1);
+
+    if (catalog.hasPlayer()) {
+        const CombatantRecord& p = catalog.player();
+        roster.add<Player>(std::string(catalog.name(p)), p.health, p.attackPower, p.level, p.criticalChance);
+    } else {
+        roster.add<Player>();
+    }
+    Player& player = *getPlayer();
+    for (std::size_t i = 0; i < catalog.inventorySize(); ++i)
+        player.addItem(catalog.internItem(catalog.startingItem(i)));
+
+    for (std::size_t i = 0; i < monsters; ++i) {
+        const CombatantRecord& m = catalog.monster(catalog.campaignSize() ? catalog.campaign(i) : i);
+        roster.add<Monster>(std::string(catalog.name(m)), m.health, m.attackPower, m.level, m.criticalChance);
+    }
+}
+
+Player* Game::getPlayer() {
+    return roster.size() ? roster.get<Player>(0) : nullptr;
+}
+
+const Player* Game::getPlayer() const {
+    return roster.size() ? roster.get<Player>(0) : nullptr;
+}
+
+void Game::setRng(Rng* rng) {
+    roster.setRng(rng);
 }
 
-Game::~Game() {
-    delete player;
-    for (auto& m : monsters) delete m;
-    monsters.clear();
+void Game::setOutput(OutputSink* sink) {
+    output = sink;
+    roster.setOutput(sink);
 }
 
-Player* Game::getPlayer() const {
-    return dynamic_cast<Player*>(player);
+void Game::reset() {
+    roster.reset();
+    stage = GameStage::Setup;
+    current = 0;
+    turns = 0;
 }
 
 void Game::showAllMonsters() const {
-    std::cout << "Monsters in the game:\n";
-    for (auto& m : monsters)
-        std::cout << "- " << m->getName() << " (HP: " << m->getHealth() << ")\n";
+    OutputSink& sink = out();
+    if (!sink.enabled()) return;
+    sink.emit({GameEventKind::RosterHeader});
+    for (std::size_t i = 1; i < roster.size(); ++i)
+        sink.emit({GameEventKind::RosterEntry, nullptr, &roster[i], roster[i].getHealth()});
+}
+
+void Game::reportStatus(const Character& c) const {
+    OutputSink& sink = out();
+    if (sink.enabled()) sink.emit({GameEventKind::Status, &c, nullptr, c.getHealth()});
+    BattleLogger::logStatus(c);
 }
 
 void Game::start() {
-    showAllMonsters();
+    stage = GameStage::Setup;
+    current = 0;
+    turns = 0;
+    while (!stepTurn().finished()) {}
+}
 
-    for (auto& m : monsters) {
-        if (!m) continue;
-        std::cout << "\nNext battle: " << m->getName() << "\n";
+GameStatus Game::status() const {
+    GameStatus s;
+    s.stage = stage;
+    s.monster = current;
+    s.turns = turns;
+    s.playerAlive = roster.size() && roster[0].isAlive();
+    return s;
+}
 
-        while(player && player->isAlive() && m->isAlive()) {
-            player->attack(*m);
-            BattleLogger::logStatus(*m);
+GameStatus Game::stepAction() {
+    OutputSink& sink = out();
 
-            if (!m->isAlive()) break;
+    switch (stage) {
+    case GameStage::Setup:
+        showAllMonsters();
+        current = 1;
+        stage = roster.size() == 0 ? GameStage::Finished : GameStage::BattleStart;
+        break;
 
-            m->attack(*player);
-            BattleLogger::logStatus(*player);
+    case GameStage::BattleStart:
+        if (current >= roster.size()) {
+            stage = GameStage::Summary;
+            break;
+        }
+        if (sink.enabled()) sink.emit({GameEventKind::BattleStart, nullptr, &roster[current]});
+        stage = roster[0].isAlive() && roster[current].isAlive() ? GameStage::PlayerAttack : GameStage::BattleEnd;
+        break;
+
+    case GameStage::PlayerAttack: {
+        Character& m = roster[current];
+        playerAction(m);
+        stage = m.isAlive() ? GameStage::MonsterAttack : GameStage::BattleEnd;
+        break;
+    }
 
-            if (player->getHealth() < 40) {
-                if (Player* p = dynamic_cast<Player*>(player)) {
-                    p->heal();
-                }
-                BattleLogger::logStatus(*player);
-            }
+    case GameStage::MonsterAttack:
+        roster.attack(current, roster[0]);
+        reportStatus(roster[0]);
+        stage = GameStage::HealCheck;
+        break;
+
+    case GameStage::HealCheck: {
+        Character& player = roster[0];
+        if (!policy && player.getHealth() < 40) {
+            roster.heal(0);
+            reportStatus(player);
+        }
+        if (sink.enabled()) sink.emit({GameEventKind::TurnEnd});
+        ++turns;
+        stage = player.isAlive() && roster[current].isAlive() ? GameStage::PlayerAttack : GameStage::BattleEnd;
+        break;
+    }
 
-            std::cout << "--------------------\n";
+    case GameStage::BattleEnd:
+        sink.flush();
+        BattleLogger::battleEnded();
+        if (roster[0].isAlive()) {
+            ++current;
+            stage = GameStage::BattleStart;
+        } else {
+            stage = GameStage::Summary;
         }
+        break;
 
-        if (!player || !player->isAlive()) break;
+    case GameStage::Summary:
+        if (sink.enabled()) {
+            const Character& player = roster[0];
+            if (const Player* p = getPlayer()) sink.emit({GameEventKind::Inventory, p});
+            sink.emit({GameEventKind::Winner, player.isAlive() ? &player : nullptr});
+        }
+        stage = GameStage::Finished;
+        break;
+
+    case GameStage::Finished:
+        break;
+    }
+    return status();
+}
+
+void Game::playerAction(Character& monster) {
+    PlayerChoice choice;
+    if (policy) {
+        const BattleSnapshot s = snapshot();
+        choice = policy->choose(s);
+        if (!s.legal(choice)) choice = PlayerChoice();
+    }
+
+    Player* player = getPlayer();
+    switch (choice.action) {
+    case PlayerAction::Attack:
+        roster.attack(0, monster);
+        reportStatus(monster);
+        break;
+    case PlayerAction::Heal:
+        roster.heal(0);
+        reportStatus(roster[0]);
+        break;
+    case PlayerAction::UseItem:
+        if (player) player->useItem(choice.item);
+        reportStatus(roster[0]);
+        break;
+    }
+}
+
+// Een beurt begint bij de aanval van de speler; wat ervoor ligt (setup,
+// einde van de vorige battle, aankondiging) hoort bij de beurt erna.
+GameStatus Game::stepTurn() {
+    RPG_TIME_SCOPE(Turn);
+    bool attacked = false;
+    for (;;) {
+        attacked = attacked || stage == GameStage::PlayerAttack;
+        stepAction();
+        if (stage == GameStage::Finished || (attacked && stage == GameStage::PlayerAttack)) break;
+    }
+    return status();
+}
+
+BattleSnapshot Game::snapshot() const {
+    auto copy = [](const Character& src, CombatantState& c) {
+        c.health = src.health;
+        c.maxHealth = src.maxHealth;
+        c.attackPower = src.attackPower;
+        c.attackBonus = src.attackBonus;
+        c.level = src.level;
+        c.criticalChance = src.criticalChance;
+        c.flags = static_cast<std::uint8_t>((src.isStunned ? CombatantState::Stunned : 0) |
+                                            (src.hasShield ? CombatantState::Shield : 0) |
+                                            (src.criticalActive ? CombatantState::CriticalActive : 0) |
+                                            (src.isPoisoned ? CombatantState::Poisoned : 0));
+    };
+
+    // Past de roster niet, dan een venster vanaf het huidige monster.
+    std::size_t first = 1;
+    std::size_t last = roster.size();
+    if (roster.size() > BattleSnapshot::kMaxCombatants) {
+        first = std::min(std::max<std::size_t>(current, 1), roster.size());
+        last = std::min(roster.size(), first + BattleSnapshot::kMaxCombatants - 1);
     }
 
-    if (player) {
-        if (Player* p = dynamic_cast<Player*>(player)) {
-            std::cout << "\n" << p->showInventory() << "\n";
+    BattleSnapshot s{};
+    s.offset = static_cast<std::uint32_t>(first - 1);
+    s.rosterSize = static_cast<std::uint32_t>(roster.size());
+    if (roster.size()) {
+        copy(roster[0], s.combatants[0]);
+        for (std::size_t i = first; i < last; ++i) copy(roster[i], s.combatants[i - s.offset]);
+        s.count = static_cast<std::uint8_t>(last - s.offset);
+    }
+    s.current = static_cast<std::uint8_t>(current < first ? current : current - s.offset);
+    s.stage = stage;
+    s.turns = turns;
+
+    if (const Player* p = getPlayer()) {
+        const ItemRegistry& items = ItemRegistry::global();
+        for (ItemId item : p->inventory) {
+            const ItemKind kind = items.kind(item);
+            if (kind != ItemKind::None) s.items[s.itemCount++] = kind;
         }
     }
+    return s;
+}
+
+void Game::restore(const BattleSnapshot& s) {
+    if (s.rosterSize != roster.size() || s.offset + s.count > roster.size())
+        throw std::invalid_argument("BattleSnapshot does not match this roster");
+
+    for (std::size_t i = 0; i < s.count; ++i) {
+        Character& c = roster[i ? s.offset + i : 0];
+        const CombatantState& src = s.combatants[i];
+        c.health = src.health;
+        c.attackBonus = src.attackBonus;
+        c.isStunned = src.flags & CombatantState::Stunned;
+        c.hasShield = src.flags & CombatantState::Shield;
+        c.criticalActive = src.flags & CombatantState::CriticalActive;
+        c.isPoisoned = src.flags & CombatantState::Poisoned;
+    }
+    stage = s.stage;
+    current = s.current ? s.offset + s.current : 0;
+    turns = s.turns;
+    // Einde van een venster is niet het einde van de campagne.
+    if ((stage == GameStage::Summary || stage == GameStage::Finished) && s.count && s.combatants[0].health > 0
+        && s.offset + s.count < roster.size()) {
+        stage = GameStage::BattleStart;
+        current = s.offset + s.count;
+    }
 
-    std::cout << "\nWinner: "
-              << (player && player->isAlive() ? player->getName() : "Monsters")
-              << "\n";
+    // De bruikbare items komen in de volgorde van de snapshot, met de ids
+    // die de speler al had (een hernoemd catalogus item blijft zo zichzelf).
+    // Items zonder effect houden hun plaats; de bruikbare items vullen de
+    // overige plaatsen en wat over is komt achteraan.
+    if (Player* p = getPlayer()) {
+        const ItemRegistry& items = ItemRegistry::global();
+        const Inventory& old = p->inventory;
+        bool used[Inventory::kCapacity] = {};
+        ItemId usable[BattleSnapshot::kMaxItems];
+        for (std::uint8_t i = 0; i < s.itemCount; ++i) {
+            usable[i] = builtinItem(s.items[i]);
+            for (std::size_t j = 0; j < old.size(); ++j) {
+                if (!used[j] && items.kind(old[j]) == s.items[i]) {
+                    used[j] = true;
+                    usable[i] = old[j];
+                    break;
+                }
+            }
+        }
+
+        Inventory kept;
+        std::uint8_t next = 0;
+        for (ItemId item : old) {
+            if (items.kind(item) == ItemKind::None) kept.add(item);
+            else if (next < s.itemCount) kept.add(usable[next++]);
+        }
+        while (next < s.itemCount) kept.add(usable[next++]);
+        p->inventory = kept;
+    }
 }
 
 } // namespace rpg
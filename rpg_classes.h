@@ -1,14 +1,27 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <sstream>
 #include <random>
 #include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <variant>
+#include "battle_logger.h"
+#include "battle_snapshot.h"
+#include "items.h"
+#include "output_sink.h"
+#include "rng.h"
 
 namespace rpg {
 
+class Catalog;
+
 // ----------------------------
 // Template functie
 // ----------------------------
@@ -17,19 +30,31 @@ T calculateDamage(const T& baseDamage, const double& multiplier = 1.0) {
     return static_cast<T>(baseDamage * multiplier);
 }
 
-// Forward declaration
-class BattleLogger;
+// ----------------------------
+// Resultaat van een enkele aanval
+// ----------------------------
+struct AttackResult {
+    int damage = 0;
+    bool critical = false;
+    bool blocked = false;
+    bool stunned = false;
+};
 
 // ----------------------------
 // Abstracte basisklasse Character
 // ----------------------------
 class Character {
     friend class BattleLogger;
+    friend class CombatantPool;
+    friend class Game;
+    friend class OutcomeSolver;
+    friend void formatGameEvent(std::string& out, const GameEvent& e);
 
 protected:
     std::string name;
     int health;
     int attackPower;
+    int attackBonus;      // van items, tot restore()
     const int maxHealth;
 
     unsigned char level;
@@ -40,12 +65,15 @@ protected:
     bool criticalActive;
     bool isPoisoned;
 
+    Rng* rng;             // nullptr = standaard generator per thread
+    OutputSink* output;   // nullptr = defaultOutput()
+
 public:
     Character(const std::string& n, int h, int a, unsigned char lvl = 1, unsigned char crit = 10)
-        : name(n), health(h), attackPower(a), maxHealth(h),
+        : name(n), health(h), attackPower(a), attackBonus(0), maxHealth(h),
         level(lvl), criticalChance(crit),
         isStunned(false), hasShield(false),
-        criticalActive(false), isPoisoned(false) {}
+        criticalActive(false), isPoisoned(false), rng(nullptr), output(nullptr) {}
 
     virtual ~Character() {}
 
@@ -55,23 +83,28 @@ public:
     inline bool isAlive() const { return health > 0; }
     inline unsigned char getLevel() const { return level; }
 
-    virtual void attack(Character& target, int multiplier = 1);
-};
+    // Zet de combatant terug naar volle HP zonder effecten.
+    void restore();
 
-// ----------------------------
-// Friend class BattleLogger
-// ----------------------------
-class BattleLogger {
-public:
-    static void logStatus(const Character& c);
+    inline void setRng(Rng* r) { rng = r; }
+    inline void setOutput(OutputSink* sink) { output = sink; }
+    inline OutputSink& out() const { return output ? *output : defaultOutput(); }
+
+    // Damage berekenen en toepassen zonder console/log output.
+    AttackResult strike(Character& target, int multiplier, Rng& random);
+
+    virtual void attack(Character& target, int multiplier = 1);
 };
 
 // ----------------------------
 // Player class
 // ----------------------------
 class Player : public Character {
+    friend class Game;
+
 private:
-    std::vector<std::string> inventory;
+    Inventory inventory;   // ids uit ItemRegistry::global()
+    Inventory starting;    // alles wat addItem() gaf; restore() zet dit terug
 
 public:
     Player();
@@ -79,8 +112,18 @@ public:
 
     void attack(Character& target, int multiplier = 1) override;
     void heal(int amount = 20);
-    void addItem(const std::string& item);
+    void applyHeal(int amount);
+    void restore();   // Character::restore() plus de start inventory
+
+    // false als de inventory vol is.
+    bool addItem(std::string_view item);
+    bool addItem(ItemId item);
     std::string showInventory() const;
+    void appendInventory(std::string& out) const;   // zelfde tekst, zonder tijdelijke strings
+    inline const Inventory& getInventory() const { return inventory; }
+
+    // Gebruikt het eerste item van deze soort; false als het er niet is.
+    bool useItem(ItemKind kind);
 };
 
 // ----------------------------
@@ -94,21 +137,119 @@ public:
     void attack(Character& target, int multiplier = 1) override;
 };
 
+// ----------------------------
+// Roster class
+// ----------------------------
+// Gesloten set combatant types: dispatch gaat via std::variant in plaats
+// van virtual calls en dynamic_cast.
+using Combatant = std::variant<Player, Monster>;
+
+template<typename T> struct CanHeal : std::false_type {};
+template<> struct CanHeal<Player> : std::true_type {};
+
+// Alle combatants van een Game in één aaneengesloten blok. Het blok komt
+// uit een arena met een inline buffer, dus een standaard roster doet geen
+// heap allocaties; reset() zet iedereen terug zonder opnieuw te alloceren.
+class Roster {
+private:
+    static constexpr std::size_t kInlineBytes = 1024;
+
+    alignas(std::max_align_t) std::byte buffer[kInlineBytes];
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<Combatant> members;
+
+public:
+    Roster();
+    Roster(const Roster& other);
+    Roster& operator=(const Roster&) = delete;
+
+    void reserve(std::size_t n);
+
+    template<typename T, typename... Args>
+    T& add(Args&&... args) {
+        return std::get<T>(members.emplace_back(std::in_place_type<T>, std::forward<Args>(args)...));
+    }
+
+    inline std::size_t size() const { return members.size(); }
+
+    Character& operator[](std::size_t i);
+    const Character& operator[](std::size_t i) const;
+
+    template<typename T> T* get(std::size_t i) { return std::get_if<T>(&members[i]); }
+    template<typename T> const T* get(std::size_t i) const { return std::get_if<T>(&members[i]); }
+
+    bool canHeal(std::size_t i) const;
+    void attack(std::size_t i, Character& target, int multiplier = 1);
+    bool heal(std::size_t i, int amount = 20);        // met output
+    bool applyHeal(std::size_t i, int amount = 20);   // zonder output
+
+    void setRng(Rng* rng);
+    void setOutput(OutputSink* sink);
+    void reset();
+};
+
 // ----------------------------
 // Game class
 // ----------------------------
+// start() speelt de hele campagne in één keer. Met stepAction()/stepTurn()
+// loopt dezelfde campagne stap voor stap, met exact dezelfde output en
+// random trekkingen; zo kan een server veel games over een paar threads
+// verdelen.
+//
+// Met een PlayerPolicy kiest de policy in PlayerAttack tussen aanvallen,
+// healen of een item gebruiken en valt de automatische heal weg; de speler
+// kan dan ook sterven. GameStage staat in battle_snapshot.h.
+
+struct GameStatus {
+    GameStage stage = GameStage::Setup;
+    std::size_t monster = 0;    // index in de roster, 0 = nog geen battle
+    std::uint32_t turns = 0;    // afgeronde beurten over de hele campagne
+    bool playerAlive = true;
+
+    inline bool finished() const { return stage == GameStage::Finished; }
+};
+
 class Game {
 private:
-    Character* player;
-    std::vector<Character*> monsters;
+    Roster roster;   // [0] = speler, daarna de monsters
+    OutputSink* output = nullptr;
+    PlayerPolicy* policy = nullptr;
+
+    GameStage stage = GameStage::Setup;
+    std::size_t current = 0;
+    std::uint32_t turns = 0;
+
+    void reportStatus(const Character& c) const;
+    void playerAction(Character& monster);
 
 public:
     Game();
-    ~Game();
-
-    Player* getPlayer() const;
+    // Speler, monsters en start inventory uit een catalogus; zonder campaign
+    // regels komen alle monsters in catalogus volgorde.
+    explicit Game(const Catalog& catalog);
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
+
+    Player* getPlayer();
+    const Player* getPlayer() const;
+    inline Roster& getRoster() { return roster; }
+    inline const Roster& getRoster() const { return roster; }
+    void setRng(Rng* rng);
+    void setOutput(OutputSink* sink);   // ook voor alle combatants
+    inline void setPolicy(PlayerPolicy* p) { policy = p; }   // nullptr = altijd aanvallen
+    inline OutputSink& out() const { return output ? *output : defaultOutput(); }
+    void reset();   // volle HP en terug naar GameStage::Setup
     void showAllMonsters() const;
     void start();
+
+    GameStatus status() const;
+    GameStatus stepAction();   // één stage verder
+    GameStatus stepTurn();     // tot en met de volgende volledige beurt
+
+    // Toestand zonder namen en zonder items die geen effect hebben. restore()
+    // verwacht een snapshot van een Game met dezelfde roster.
+    BattleSnapshot snapshot() const;
+    void restore(const BattleSnapshot& s);
 };
 
 } // namespace rpg
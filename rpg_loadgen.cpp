@@ -0,0 +1,57 @@
+#include "session_scheduler.h"
+#include <iostream>
+#include <string>
+
+using namespace rpg;
+
+// ----------------------------
+// rpg_loadgen
+// ----------------------------
+// Start veel headless game sessies en laat de SessionScheduler ze uitspelen.
+// rpg_loadgen [sessions] [threads] [batch] [turnsPerSlice] [seed] [--log]
+// Zonder --log staat de BattleLogger uit, zodat alleen de game core gemeten wordt.
+int main(int argc, char* argv[]) {
+    try {
+        std::size_t sessions = 20000;
+        SchedulerConfig config;
+        std::uint64_t seed = 5489;
+        bool logging = false;
+
+        int position = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--log") {
+                logging = true;
+                continue;
+            }
+            switch (position++) {
+            case 0: sessions = std::stoull(arg); break;
+            case 1: config.threads = static_cast<unsigned>(std::stoul(arg)); break;
+            case 2: config.batchSize = std::stoull(arg); break;
+            case 3: config.turnsPerSlice = static_cast<std::uint32_t>(std::stoul(arg)); break;
+            case 4: seed = std::stoull(arg); break;
+            default:
+                std::cerr << "Usage: rpg_loadgen [sessions] [threads] [batch] [turnsPerSlice] [seed] [--log]\n";
+                return 1;
+            }
+        }
+
+        LoggerConfig logConfig;
+        logConfig.enabled = logging;
+        BattleLogger::configure(logConfig);
+
+        SessionScheduler scheduler(config);
+        for (std::size_t i = 0; i < sessions; ++i) scheduler.addSession(seed);
+
+        SchedulerReport report = scheduler.run();
+        printSchedulerReport(std::cout, report);
+
+        std::uint64_t wins = 0;
+        for (std::size_t i = 0; i < scheduler.size(); ++i) wins += scheduler.session(i).metrics.won ? 1 : 0;
+        std::cout << "Player wins: " << wins << "/" << scheduler.size() << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
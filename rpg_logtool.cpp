@@ -0,0 +1,138 @@
+#include "battle_event_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace rpg;
+
+// ----------------------------
+// rpg_logtool
+// ----------------------------
+// rpg_logtool stats <log.bin> [bucket]    damage histogram, crit rate, battle duur
+// rpg_logtool to-text <log.bin> <out.txt>
+// rpg_logtool to-binary <log.txt> <out.bin>
+
+static int usage() {
+    std::cerr << "Usage: rpg_logtool stats <log.bin> [bucket]\n"
+              << "       rpg_logtool to-text <log.bin> <out.txt>\n"
+              << "       rpg_logtool to-binary <log.txt> <out.bin>\n";
+    return 1;
+}
+
+static int printStats(const std::string& path, int bucket) {
+    EventLogView log(path);
+    const NameTable& names = log.names();
+
+    struct PerCharacter { std::uint64_t attacks = 0; std::uint64_t crits = 0; std::uint64_t damage = 0; };
+    std::vector<PerCharacter> perCharacter(names.size());
+    // Damage komt uit het bestand: vanaf kMaxBuckets gaat alles in één
+    // overflow bucket, zodat een grote waarde geen grote allocatie wordt.
+    constexpr std::size_t kMaxBuckets = 1024;
+    std::vector<std::uint64_t> histogram;
+    std::uint64_t overflow = 0;
+    // De writer nummert battles oplopend: tel per battle tot het id wijzigt.
+    std::vector<std::uint32_t> durations;   // aanvallen per battle
+    std::uint32_t battle = 0;
+    std::uint32_t battleAttacks = 0;
+    std::uint64_t attacks = 0;
+
+    // Eén lineaire pass over de gemapte records.
+    for (const EventRecord& e : log) {
+        log.check(e);
+        if (e.kind != static_cast<std::uint8_t>(EventKind::Attack)) continue;
+        ++attacks;
+        PerCharacter& pc = perCharacter[e.actor];
+        ++pc.attacks;
+        pc.crits += (e.flags & EventCritical) ? 1 : 0;
+        pc.damage += static_cast<std::uint64_t>(std::max(e.damage, 0));
+
+        const std::size_t b = static_cast<std::size_t>(std::max(e.damage, 0) / bucket);
+        if (b >= kMaxBuckets) {
+            ++overflow;
+        } else {
+            if (b >= histogram.size()) histogram.resize(b + 1, 0);
+            ++histogram[b];
+        }
+
+        if (e.battle != battle && battleAttacks) {
+            durations.push_back(battleAttacks);
+            battleAttacks = 0;
+        }
+        battle = e.battle;
+        ++battleAttacks;
+    }
+    if (battleAttacks) durations.push_back(battleAttacks);
+
+    std::cout << "Records: " << log.size() << ", attacks: " << attacks
+              << ", combatants: " << names.size() << "\n\nDamage histogram:\n";
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        if (!histogram[i]) continue;
+        std::cout << std::setw(5) << i * bucket << "-" << std::setw(5) << (i + 1) * bucket - 1
+                  << ": " << histogram[i] << "\n";
+    }
+    if (overflow) std::cout << std::setw(5) << kMaxBuckets * bucket << "+     : " << overflow << "\n";
+
+    std::cout << "\nCrit rate per character:\n" << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < perCharacter.size(); ++i) {
+        const PerCharacter& pc = perCharacter[i];
+        if (!pc.attacks) continue;
+        std::cout << "- " << names[static_cast<std::uint16_t>(i)].name << ": "
+                  << 100.0 * static_cast<double>(pc.crits) / static_cast<double>(pc.attacks) << "% of "
+                  << pc.attacks << " attacks, avg damage "
+                  << static_cast<double>(pc.damage) / static_cast<double>(pc.attacks) << "\n";
+    }
+
+    std::sort(durations.begin(), durations.end());
+    std::cout << "\nBattles: " << durations.size();
+    if (!durations.empty()) {
+        std::uint64_t sum = 0;
+        for (std::uint32_t t : durations) sum += t;
+        std::cout << ", attacks per battle: min " << durations.front()
+                  << ", mean " << static_cast<double>(sum) / static_cast<double>(durations.size())
+                  << ", p50 " << durations[durations.size() / 2]
+                  << ", max " << durations.back();
+    }
+    std::cout << "\n";
+    return 0;
+}
+
+static int toText(const std::string& in, const std::string& out) {
+    EventLogView log(in);
+    std::ofstream file(out, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::ios_base::failure("Cannot open " + out);
+    writeTextLog(log, file);
+    return 0;
+}
+
+static int toBinary(const std::string& in, const std::string& out) {
+    std::ifstream file(in);
+    if (!file) throw std::ios_base::failure("Cannot open " + in);
+    std::remove(out.c_str());
+
+    EventLogWriter writer;
+    if (!writer.open(out)) throw std::ios_base::failure("Cannot open " + out);
+    const std::uint64_t skipped = convertTextLog(file, writer);
+    writer.close();
+
+    if (skipped) std::cerr << "Skipped " << skipped << " lines that are not battle events\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) return usage();
+        std::string command = argv[1];
+        if (command == "stats")
+            return printStats(argv[2], argc > 3 ? std::max(1, std::stoi(argv[3])) : 5);
+        if (command == "to-text" && argc > 3) return toText(argv[2], argv[3]);
+        if (command == "to-binary" && argc > 3) return toBinary(argv[2], argv[3]);
+        return usage();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -1,18 +1,557 @@
 #include "rpg_classes.h"
+#include "auto_player.h"
+#include "battle_event_log.h"
+#include "combatant_pool.h"
+#include "battle_simulator.h"
+#include "catalog.h"
+#include "damage_pipeline.h"
+#include "instrumentation.h"
+#include "session_scheduler.h"
+#include "outcome_solver.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <fstream>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
 
 using namespace rpg;
 
+// De integer pipeline moet exact gelijk zijn aan het oude double pad.
+constexpr bool pipelineMatchesGeneric(int maxRaw) {
+    for (int raw = 0; raw <= maxRaw; ++raw) {
+        DamageTable t = StandardDamage::table(DamageContext{raw});
+        for (int v = 8; v <= 12; ++v)
+            for (int crit = 0; crit < 2; ++crit)
+                for (int shield = 0; shield < 2; ++shield)
+                    if (t(v, crit, shield) != genericDamage(raw, v, crit, shield)) return false;
+    }
+    return true;
+}
+static_assert(pipelineMatchesGeneric(300), "StandardDamage differs from the double damage path");
+
+// ExtendedDamage: gelijke levels en geen element is StandardDamage; level
+// verschil en elementen schalen in procenten, voor het shield afkappen.
+constexpr bool extendedMatchesStandard(int maxRaw) {
+    for (int raw = 0; raw <= maxRaw; ++raw) {
+        DamageContext c{raw};
+        c.attackerLevel = c.defenderLevel = 7;
+        DamageTable extended = ExtendedDamage::table(c);
+        DamageTable standard = StandardDamage::table(c);
+        for (std::size_t i = 0; i < DamageTable::kSize; ++i)
+            if (extended.values[i] != standard.values[i]) return false;
+    }
+    return true;
+}
+
+constexpr int extendedHit(unsigned char attackerLevel, unsigned char defenderLevel, Element attack, Element defender,
+                          bool critical = false, bool shielded = false) {
+    DamageContext c{20};
+    c.attackerLevel = attackerLevel;
+    c.defenderLevel = defenderLevel;
+    c.attackElement = attack;
+    c.defenderElement = defender;
+    c.critical = critical;
+    c.shielded = shielded;
+    return ExtendedDamage::apply(c);
+}
+
+static_assert(extendedMatchesStandard(300), "ExtendedDamage differs from StandardDamage without levels or elements");
+static_assert(extendedHit(3, 1, Element::None, Element::None) == 24, "LevelScalingModifier<10>: +2 levels is 120%");
+static_assert(extendedHit(1, 20, Element::None, Element::None) == 0, "LevelScalingModifier never goes below 0%");
+static_assert(extendedHit(1, 1, Element::Fire, Element::Ice) == 40 && extendedHit(1, 1, Element::Fire, Element::Fire) == 10,
+              "ElementalModifier follows kElementChart");
+static_assert(extendedHit(3, 1, Element::Fire, Element::Ice, true, true) == 48, "ExtendedDamage combines all modifiers");
+
 int main() {
     Player p("Tester", 50, 10, 1, 0);
     p.heal(20);
-    assert(p.getHealth() == 70);
+    assert(p.getHealth() == 50);   // heal kapt af op maxHealth
 
     Monster m("Dummy", 50, 10, 1, 0);
     p.attack(m);
     assert(m.getHealth() <= 50);
 
+    LoggerConfig cfg;
+    cfg.path = "rpg_tests_log.txt";
+    std::remove(cfg.path.c_str());
+    BattleLogger::configure(cfg);
+    BattleLogger::logStatus(m);
+    BattleLogger::flush();
+    std::ifstream log(cfg.path);
+    std::string line;
+    std::getline(log, line);
+    assert(line == "[LOG] Dummy (Lv 1) HP: " + std::to_string(m.getHealth()) + "/50");
+
+    // SoA wave kernel moet gelijk zijn aan het per-object pad bij dezelfde rolls,
+    // ook met dode slots (die krijgen geen rolls en geen damage)
+    std::vector<Monster> wave;
+    CombatantPool pool;
+    for (int i = 0; i < 1000; ++i) {
+        wave.emplace_back("Imp", i % 7 == 0 ? 0 : 20 + i % 40, 5 + i % 13, 1, static_cast<unsigned char>(i % 60));
+        pool.add(wave.back());
+    }
+    Player hero("Hero", 100, 18, 1, 20);
+    CounterRng rngA(42), rngB(42);
+    WaveRolls rolls;
+    WaveResult result;
+    rolls.draw(rngA, pool);
+    pool.strikeAll(hero, 1, rolls, result);
+    for (std::size_t i = 0; i < wave.size(); ++i) {
+        if (!wave[i].isAlive()) {
+            assert(result.damage[i] == 0 && pool.getHealth(i) == 0);
+            continue;
+        }
+        [[maybe_unused]] AttackResult hit = hero.strike(wave[i], 1, rngB);
+        assert(hit.damage == result.damage[i]);
+        assert(wave[i].getHealth() == pool.getHealth(i));
+    }
+    assert(rngA.tell() == rngB.tell());
+
+    // CounterRng: seek() is gelijk aan doortrekken; replay is bit-exact
+    CounterRng seq(7, 3), jump(7, 3);
+    for (int i = 0; i < 10; ++i) seq.next();
+    jump.seek(10);
+    assert(seq.next() == jump.next());
+
+    Game game;
+    assert(game.getPlayer() != nullptr);
+    assert(game.getRoster().size() == 4);
+    assert(game.getRoster().canHeal(0) && !game.getRoster().canHeal(1));
+    BattleSimulator simulator(game);
+    SimulationConfig simConfig;
+    BattleReplay replay = simulator.record(simConfig, 99);
+    saveReplay("rpg_tests_replay.bin", replay);
+    BattleReplay loaded = loadReplay("rpg_tests_replay.bin");
+    {
+        // Een count groter dan het bestand wordt geweigerd voor de reserve
+        std::ifstream in("rpg_tests_replay.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        bytes.replace(38, 4, "\xff\xff\xff\xff");
+        std::ofstream("rpg_tests_replay.bin", std::ios::binary | std::ios::trunc) << bytes;
+        [[maybe_unused]] bool truncated = false;
+        try {
+            loadReplay("rpg_tests_replay.bin");
+        } catch (const std::runtime_error& e) {
+            truncated = std::string(e.what()) == "Replay file is truncated";
+        }
+        assert(truncated);
+    }
+    std::remove("rpg_tests_replay.bin");
+    [[maybe_unused]] CampaignResult again = simulator.replay(loaded);
+    assert(loaded.decisions.size() == replay.decisions.size());
+    assert(again.hpRemaining == replay.expected.hpRemaining);
+    assert(again.turns == replay.expected.turns);
+
+    // Output sinks: PerTurn geeft dezelfde tekst als PerEvent, de callback
+    // krijgt de events zelf en de NullSink schrijft niets
+    std::ostringstream perEvent, perTurn;
+    for (int mode = 0; mode < 2; ++mode) {
+        ConsoleSink console(mode ? perTurn : perEvent,
+                            mode ? ConsoleSink::Mode::PerTurn : ConsoleSink::Mode::PerEvent);
+        Game g;
+        CounterRng sinkRng(11);
+        g.setRng(&sinkRng);
+        g.setOutput(&console);
+        g.start();
+    }
+    assert(!perEvent.str().empty() && perEvent.str() == perTurn.str());
+
+    int attacks = 0, winners = 0;
+    CallbackSink callback([&](const GameEvent& e) {
+        attacks += e.kind == GameEventKind::Attack;
+        winners += e.kind == GameEventKind::Winner;
+    });
+    NullSink quiet;
+    for (OutputSink* sink : {static_cast<OutputSink*>(&callback), static_cast<OutputSink*>(&quiet)}) {
+        Game g;
+        CounterRng sinkRng(11);
+        g.setRng(&sinkRng);
+        g.setOutput(sink);
+        g.start();
+    }
+    assert(attacks > 0 && winners == 1);
+
+    // SessionScheduler: stap voor stap over meerdere threads geeft hetzelfde
+    // resultaat als Game::start met dezelfde generator
+    SchedulerConfig schedConfig;
+    schedConfig.threads = 3;
+    schedConfig.batchSize = 5;
+    SessionScheduler scheduler(schedConfig);
+    for (int i = 0; i < 40; ++i) scheduler.addSession(77);
+    SchedulerReport schedReport = scheduler.run();
+    assert(schedReport.sessions == 40 && schedReport.completion.count == 40);
+    for (std::size_t i = 0; i < 40; i += 13) {
+        Game g;
+        CounterRng r = CounterRng::forBattle(77, i);
+        NullSink none;
+        g.setRng(&r);
+        g.setOutput(&none);
+        g.start();
+        assert(g.status().finished());
+        assert(g.getRoster()[0].getHealth() == scheduler.session(i).metrics.hpRemaining);
+        assert(g.status().turns == scheduler.session(i).metrics.turns);
+    }
+
+    // OutcomeSolver: exact tegen Monte Carlo, en de heal regel maakt de
+    // speler onverslaanbaar (heal op 0 HP)
+    OutcomeSolver solver;
+    CampaignOutcome exact = solver.solve(game);
+    double turnMass = 0.0;
+    for (double t : exact.turns) turnMass += t;
+    assert(std::abs(turnMass - 1.0) < 1e-9 && std::abs(exact.winProbability - 1.0) < 1e-9);
+    SimulationConfig mcConfig;
+    mcConfig.battles = 20000;
+    SimulationStats mc = simulator.run(mcConfig);
+    assert(std::abs(mc.turns.mean() - exact.expectedTurns) < 0.1);
+    assert(std::abs(mc.hpRemaining.mean() - exact.expectedHp) < 1.0);
+    solver.solve(game);
+    assert(solver.cacheHits() == 3);
+
+    SolverConfig noHeal;
+    noHeal.healAmount = 0;
+    CampaignOutcome risky = OutcomeSolver(noHeal).solve(game);
+    assert(risky.winProbability < 1.0 && std::abs(risky.hpRemaining[0] - (1.0 - risky.winProbability)) < 1e-9);
+
+    // BattleSnapshot: Game met een PlayerPolicy en playTurn() op een snapshot
+    // trekken dezelfde rolls en komen in dezelfde toestand uit
+    [[maybe_unused]] auto sameState = [](const BattleSnapshot& a, const BattleSnapshot& b) {
+        if (a.count != b.count || a.current != b.current || a.stage != b.stage || a.turns != b.turns ||
+            a.itemCount != b.itemCount) return false;
+        for (std::size_t i = 0; i < a.count; ++i) {
+            const CombatantState& x = a.combatants[i];
+            const CombatantState& y = b.combatants[i];
+            if (x.health != y.health || x.attackBonus != y.attackBonus || x.flags != y.flags) return false;
+        }
+        for (std::size_t i = 0; i < a.itemCount; ++i)
+            if (a.items[i] != b.items[i]) return false;
+        return true;
+    };
+    struct RolloutPolicy : PlayerPolicy {
+        PlayerChoice choose(const BattleSnapshot& s) override { return AutoPlayer::rolloutChoice(s, 40); }
+    } rolloutPolicy;
+
+    Game scripted;
+    NullSink silent;
+    scripted.setOutput(&silent);
+    for (const char* item : {"Rope", "Sword", "Potion", "Shield"}) scripted.getPlayer()->addItem(item);
+    const BattleSnapshot initial = scripted.snapshot();
+    assert(initial.count == 4 && initial.itemCount == 3 && initial.stage == GameStage::Setup);
+
+    BattleSnapshot sim = initial;
+    CounterRng simRng(21), gameRng(21);
+    advance(sim, simRng);
+    while (!sim.finished()) playTurn(sim, AutoPlayer::rolloutChoice(sim, 40), simRng);
+    scripted.setRng(&gameRng);
+    scripted.setPolicy(&rolloutPolicy);
+    scripted.start();
+    assert(sameState(scripted.snapshot(), sim) && simRng.tell() == gameRng.tell());
+    assert(sim.combatants[0].attackBonus == kSwordBonus && (sim.combatants[0].flags & CombatantState::Shield));
+
+    // Game::reset() geeft de start inventory terug, ook als items gebruikt zijn
+    assert(scripted.getPlayer()->getInventory().size() < 4);
+    scripted.reset();
+    assert(sameState(scripted.snapshot(), initial));
+    assert(scripted.getPlayer()->showInventory() == "Hero's Inventory: Rope Sword Potion Shield ");
+
+    // restore() neemt een snapshot over, items zonder effect blijven staan
+    BattleSnapshot mid = initial;
+    advance(mid, simRng);
+    PlayerChoice useSword;
+    useSword.action = PlayerAction::UseItem;
+    useSword.item = ItemKind::Sword;
+    assert(mid.legal(useSword));
+    playTurn(mid, useSword, simRng);
+    scripted.restore(mid);
+    assert(sameState(scripted.snapshot(), mid));
+    assert(scripted.getPlayer()->showInventory() == "Hero's Inventory: Rope Potion Shield ");
+    scripted.restore(initial);
+    assert(scripted.getPlayer()->getInventory().size() == 4 && sameState(scripted.snapshot(), initial));
+    assert(scripted.getPlayer()->showInventory() == "Hero's Inventory: Rope Sword Potion Shield ");
+    BattleSnapshot reordered = initial;
+    reordered.items[0] = ItemKind::Shield;
+    reordered.items[1] = ItemKind::Potion;
+    reordered.itemCount = 2;
+    scripted.restore(reordered);
+    assert(scripted.getPlayer()->showInventory() == "Hero's Inventory: Rope Shield Potion ");
+    scripted.restore(initial);
+
+    // restore(snapshot()) houdt elk item, ook een volle inventory
+    Game stocked;
+    while (stocked.getPlayer()->addItem("Potion")) {}
+    [[maybe_unused]] const std::string fullInventory = stocked.getPlayer()->showInventory();
+    assert(stocked.getPlayer()->getInventory().size() == Inventory::kCapacity);
+    assert(stocked.snapshot().itemCount == Inventory::kCapacity);
+    stocked.restore(stocked.snapshot());
+    assert(stocked.getPlayer()->showInventory() == fullInventory);
+
+    // AutoPlayer: met een vast aantal iteraties deterministisch en legaal
+    AutoPlayerConfig autoConfig;
+    autoConfig.threads = 2;
+    autoConfig.timeBudget = std::chrono::milliseconds(0);
+    autoConfig.maxIterations = 300;
+    AutoPlayer autoA(autoConfig), autoB(autoConfig);
+    BattleSnapshot decision = initial;
+    advance(decision, simRng);
+    [[maybe_unused]] PlayerChoice pickA = autoA.choose(decision);
+    [[maybe_unused]] PlayerChoice pickB = autoB.choose(decision);
+    assert(decision.legal(pickA) && pickA.action == pickB.action && pickA.item == pickB.item);
+    assert(autoA.lastSearch().iterations == 600 && autoA.lastSearch().visits == autoB.lastSearch().visits);
+
+    autoConfig.threads = 1;
+    autoConfig.maxIterations = 100;
+    AutoPlayer autoGame(autoConfig);
+    Game automated;
+    CounterRng autoRng(3);
+    automated.setOutput(&silent);
+    automated.setRng(&autoRng);
+    automated.setPolicy(&autoGame);
+    automated.start();
+    assert(automated.status().finished());
+
+    // Een catalogus roster groter dan een BattleSnapshot: de snapshot is een
+    // venster vanaf het huidige monster en de policy speelt de hele campagne
+    {
+        std::istringstream text("player Hero 100 20 1 0\nmonster Rat 1 1 1 0\n"
+                                "campaign Rat Rat Rat Rat Rat Rat Rat Rat Rat Rat Rat Rat\n");
+        Game large(parseCatalog(text, "large"));
+        assert(large.getRoster().size() == 13 && large.getRoster().size() > BattleSnapshot::kMaxCombatants);
+        CounterRng largeRng(4);
+        large.setOutput(&silent);
+        large.setRng(&largeRng);
+
+        BattleSnapshot window = large.snapshot();
+        assert(window.count == BattleSnapshot::kMaxCombatants && window.offset == 0 && window.rosterSize == 13);
+        while (!window.finished()) playTurn(window, PlayerChoice(), largeRng);
+        assert(window.playerWon());
+        large.restore(window);   // einde van het venster: verder met monster 8
+        assert(!large.status().finished() && large.status().monster == BattleSnapshot::kMaxCombatants);
+        assert(large.snapshot().offset == BattleSnapshot::kMaxCombatants - 1);
+
+        large.setPolicy(&autoGame);
+        large.start();
+        assert(large.status().finished() && large.status().playerAlive && large.status().monster == 13);
+    }
+
+    // Zonder tijdsbudget en zonder limiet zou choose() nooit stoppen
+    autoConfig.maxIterations = 0;
+    [[maybe_unused]] bool unbounded = false;
+    try {
+        AutoPlayer never(autoConfig);
+    } catch (const std::invalid_argument&) {
+        unbounded = true;
+    }
+    assert(unbounded);
+
+    // ItemRegistry en Inventory: ingebouwde items op hun ItemKind, namen
+    // worden één keer geïnterned en de inventory heeft een vaste grootte
+    ItemRegistry& registry = ItemRegistry::global();
+    assert(registry.intern("Shield") == builtinItem(ItemKind::Shield) && registry.name(builtinItem(ItemKind::Potion)) == "Potion");
+    [[maybe_unused]] const ItemId rope = registry.intern("Rope");
+    assert(registry.intern("Rope") == rope && registry.find("Rope") == rope && registry.kind(rope) == ItemKind::None);
+    assert(registry.find("Nothing such") == kNoItem);
+    Player packer("Packer", 50, 10, 1, 0);
+    assert(packer.showInventory() == "Packer's inventory is empty.");
+    for (std::size_t i = 0; i < Inventory::kCapacity; ++i) assert(packer.addItem(i % 2 ? "Rope" : "Sword"));
+    assert(!packer.addItem("Potion") && packer.getInventory().full());
+
+    // Catalog: tekst en binair geven dezelfde catalogus, en een Game uit de
+    // catalogus speelt exact als de ingebouwde Game met dezelfde items
+    std::istringstream catalogText(
+        "# standaard campagne\n"
+        "player Hero 100 18 1 20\n"
+        "monster Goblin 80 12 1 10\n"
+        "monster Orc 120 18 2 15\n"
+        "monster Troll 150 20 3 5\n"
+        "monster Dragon 400 35 9 25   # niet in de campaign\n"
+        "item Sword\n"
+        "item Shield\n"
+        "item Excalibur Sword\n"
+        "campaign Goblin Orc\n"
+        "campaign Troll\n"
+        "inventory Sword Shield\n");
+    Catalog parsed = parseCatalog(catalogText, "test");
+    assert(parsed.monsterCount() == 4 && parsed.itemCount() == 3 && parsed.campaignSize() == 3);
+    assert(parsed.findMonster("Dragon") == 3 && parsed.findMonster("Dwarf") == Catalog::kNotFound);
+    assert(registry.kind(parsed.internItem(parsed.findItem("Excalibur"))) == ItemKind::Sword);
+
+    saveCatalog("rpg_tests_catalog.bin", parsed);
+    Catalog mappedCatalog = loadCatalog("rpg_tests_catalog.bin");
+    assert(mappedCatalog.size() == parsed.size());
+    assert(std::equal(parsed.data(), parsed.data() + parsed.size(), mappedCatalog.data()));
+    assert(mappedCatalog.name(mappedCatalog.monster(mappedCatalog.findMonster("Orc"))) == "Orc");
+
+    std::string builtinText, catalogGameText;
+    for (int mode = 0; mode < 2; ++mode) {
+        std::ostringstream text;
+        ConsoleSink console(text);
+        CounterRng catalogRng(31);
+        std::unique_ptr<Game> g(mode ? new Game(mappedCatalog) : new Game());
+        if (!mode) {
+            g->getPlayer()->addItem("Sword");
+            g->getPlayer()->addItem("Shield");
+        }
+        g->setRng(&catalogRng);
+        g->setOutput(&console);
+        g->start();
+        console.flush();
+        (mode ? catalogGameText : builtinText) = text.str();
+    }
+    assert(!builtinText.empty() && builtinText == catalogGameText);
+    assert(builtinText.find("Hero's Inventory: Sword Shield \n") != std::string::npos);
+
+    [[maybe_unused]] bool rejected = false;
+    try {
+        std::istringstream bad("monster Goblin 80 12 1 10\ncampaign Goblin Orc\n");
+        parseCatalog(bad, "bad");
+    } catch (const std::runtime_error& e) {
+        rejected = std::string(e.what()) == "bad:2: unknown monster 'Orc'";
+    }
+    assert(rejected);
+    std::remove("rpg_tests_catalog.bin");
+
+    // EventLogView: een record met een onbekende combatant wordt in de pass
+    // van de lezer geweigerd
+    {
+        std::remove("rpg_tests_events.bin");
+        EventLogWriter writer;
+        assert(writer.open("rpg_tests_events.bin"));
+        EventRecord e{};
+        e.kind = static_cast<std::uint8_t>(EventKind::Attack);
+        e.actor = writer.names().intern("Hero", 1, 100);
+        e.target = writer.names().intern("Goblin", 1, 80);
+        e.damage = 12;
+        writer.append(e);
+        writer.endBattle();
+        writer.close();
+        assert(EventLogView("rpg_tests_events.bin").size() == 2);
+
+        std::fstream patch("rpg_tests_events.bin", std::ios::in | std::ios::out | std::ios::binary);
+        const std::uint16_t badActor = 60000;
+        patch.seekp(static_cast<std::streamoff>(sizeof(EventLogHeader) + offsetof(EventRecord, actor)));
+        patch.write(reinterpret_cast<const char*>(&badActor), sizeof(badActor));
+        patch.close();
+        [[maybe_unused]] bool corrupt = false;
+        {
+            EventLogView view("rpg_tests_events.bin");
+            assert(!view.valid(*view.begin()) && view.valid(*(view.begin() + 1)));
+            try {
+                std::ostringstream text;
+                writeTextLog(view, text);
+            } catch (const std::runtime_error&) {
+                corrupt = true;
+            }
+        }
+        assert(corrupt);
+        std::remove("rpg_tests_events.bin");
+    }
+
+    // parseEventLine: getallen buiten int zijn geen event
+    {
+        [[maybe_unused]] NameTable names;
+        [[maybe_unused]] EventRecord e;
+        assert(parseEventLine("Hero attacks Goblin for 12 damage", names, e) && e.damage == 12);
+        assert(!parseEventLine("Hero attacks Goblin for 99999999999 damage", names, e));
+        assert(!parseEventLine("[LOG] Hero (Lv 1) HP: -2147483649/100", names, e));
+    }
+
+    // Binaire logger: met een vol name table worden records geteld als
+    // dropped in plaats van de writer thread te stoppen
+    {
+        LoggerConfig binary;
+        binary.path = "rpg_tests_events.bin";
+        binary.format = LogFormat::Binary;
+        std::remove(binary.path.c_str());
+        BattleLogger::configure(binary);
+        for (int i = 0; i <= 0x10000; ++i) BattleLogger::logStatus(Monster("M" + std::to_string(i), 10, 1, 1, 0));
+        BattleLogger::flush();
+        assert(BattleLogger::droppedLines() == 1);
+        BattleLogger::configure(cfg);
+        assert(EventLogView("rpg_tests_events.bin").names().size() == 0x10000);
+        std::remove("rpg_tests_events.bin");
+    }
+
+    // Round trip: dezelfde campagne in tekst en binair geeft dezelfde regels,
+    // ook na tekst -> binair -> tekst; de tekst log wordt niet overschreven
+    {
+        auto play = [&](const LoggerConfig& config) {
+            std::remove(config.path.c_str());
+            BattleLogger::configure(config);
+            Game logged;
+            CounterRng logRng(11);
+            logged.setOutput(&silent);
+            logged.setRng(&logRng);
+            logged.start();
+            BattleLogger::flush();
+        };
+        LoggerConfig textConfig, binaryConfig;
+        textConfig.path = "rpg_tests_roundtrip.txt";
+        binaryConfig.path = "rpg_tests_roundtrip.bin";
+        binaryConfig.format = LogFormat::Binary;
+        play(textConfig);
+        play(binaryConfig);
+        BattleLogger::configure(cfg);
+
+        std::ifstream textFile(textConfig.path, std::ios::binary);
+        std::stringstream text;
+        text << textFile.rdbuf();
+        textFile.close();
+        assert(text.str().find(" attacks ") != std::string::npos);
+
+        std::ostringstream fromBinary;
+        writeTextLog(EventLogView(binaryConfig.path), fromBinary);
+        assert(fromBinary.str() == text.str());
+
+        std::remove("rpg_tests_converted.bin");
+        EventLogWriter converted;
+        assert(converted.open("rpg_tests_converted.bin"));
+        std::istringstream lines(text.str());
+        assert(convertTextLog(lines, converted) == 0);
+        converted.close();
+        std::ostringstream backToText;
+        writeTextLog(EventLogView("rpg_tests_converted.bin"), backToText);
+        assert(backToText.str() == text.str());
+
+        EventLogWriter wrongFile;
+        assert(!wrongFile.open(textConfig.path));
+        std::ifstream untouched(textConfig.path, std::ios::binary);
+        std::stringstream after;
+        after << untouched.rdbuf();
+        untouched.close();
+        assert(after.str() == text.str());
+        assert(LoggerConfig().path.empty());
+
+        std::remove(textConfig.path.c_str());
+        std::remove(binaryConfig.path.c_str());
+        std::remove("rpg_tests_converted.bin");
+    }
+
+    // Instrumentatie: alleen tellers in een RPG_INSTRUMENTATION build
+    Instrumentation::reset();
+    Game timed;
+    CounterRng timedRng(5);
+    timed.setOutput(&silent);
+    timed.setRng(&timedRng);
+    timed.start();
+    InstrumentationSnapshot snap = Instrumentation::snapshot();
+#if RPG_INSTRUMENTATION
+    assert(snap[Counter::Attacks] > 0);
+    assert(snap[Phase::Attack].count == snap[Counter::Attacks] + snap[Counter::StunnedTurns]);
+    assert(snap[Phase::Damage].count == snap[Phase::Attack].count);
+    assert(snap[Phase::Turn].count > 0 && snap[Phase::LogStatus].count > snap[Phase::Turn].count);
+#else
+    assert(snap[Counter::Attacks] == 0 && snap[Phase::Attack].count == 0);
+#endif
+
+    BattleLogger::shutdown();
+    std::remove(cfg.path.c_str());
+
     std::cout << "All tests passed!\n";
     return 0;
 }
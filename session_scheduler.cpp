@@ -0,0 +1,236 @@
+#include "session_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace rpg {
+
+// ----------------------------
+// Worker: eigen rij batches + lokale statistieken
+// ----------------------------
+class SessionScheduler::Worker {
+public:
+    // Geeft de lengte van de rij terug na het toevoegen.
+    std::size_t push(Batch* batch) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(batch);
+        return queue.size();
+    }
+
+    // Eigen werk van voren (FIFO, round robin over de batches).
+    Batch* popFront() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return nullptr;
+        Batch* b = queue.front();
+        queue.pop_front();
+        return b;
+    }
+
+    // Dieven nemen van achteren, zodat ze de eigenaar zo min mogelijk storen.
+    Batch* stealBack() {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.empty()) return nullptr;
+        Batch* b = queue.back();
+        queue.pop_back();
+        return b;
+    }
+
+    std::uint64_t turns = 0;
+    std::uint64_t slices = 0;
+    std::uint64_t steals = 0;
+    PhaseStats sliceGap;
+    PhaseStats completion;
+
+private:
+    std::mutex mutex;
+    std::deque<Batch*> queue;
+};
+
+// ----------------------------
+// SchedulerReport
+// ----------------------------
+double SchedulerReport::turnsPerSecond() const {
+    return seconds > 0.0 ? static_cast<double>(turns) / seconds : 0.0;
+}
+
+double SchedulerReport::sessionsPerSecond() const {
+    return seconds > 0.0 ? static_cast<double>(sessions) / seconds : 0.0;
+}
+
+void printSchedulerReport(std::ostream& os, const SchedulerReport& r) {
+    const auto oldFlags = os.flags();
+    const auto oldPrecision = os.precision();
+    os << std::fixed << std::setprecision(1)
+       << "Sessions: " << r.sessions << ", turns: " << r.turns
+       << ", wall time: " << r.seconds * 1000.0 << " ms\n"
+       << "Throughput: " << r.turnsPerSecond() << " turns/s, "
+       << r.sessionsPerSecond() << " sessions/s\n"
+       << "Slice gap (us): mean " << r.sliceGap.meanNs() / 1000.0
+       << ", p50 " << static_cast<double>(r.sliceGap.percentileNs(0.5)) / 1000.0
+       << ", p99 " << static_cast<double>(r.sliceGap.percentileNs(0.99)) / 1000.0
+       << ", max " << static_cast<double>(r.sliceGap.maxNs) / 1000.0 << "\n"
+       << "Session completion (us): mean " << r.completion.meanNs() / 1000.0
+       << ", p50 " << static_cast<double>(r.completion.percentileNs(0.5)) / 1000.0
+       << ", p99 " << static_cast<double>(r.completion.percentileNs(0.99)) / 1000.0
+       << ", max " << static_cast<double>(r.completion.maxNs) / 1000.0 << "\n"
+       << "Batch slices: " << r.slices << ", steals: " << r.steals << ", turns per worker:";
+    for (std::uint64_t t : r.turnsPerWorker) os << " " << t;
+    os << "\n";
+    os.flags(oldFlags);
+    os.precision(oldPrecision);
+}
+
+// ----------------------------
+// SessionScheduler
+// ----------------------------
+SessionScheduler::SessionScheduler(const SchedulerConfig& cfg)
+    : config(cfg) {
+    if (config.batchSize == 0) config.batchSize = 1;
+    if (config.turnsPerSlice == 0) config.turnsPerSlice = 1;
+}
+
+std::size_t SessionScheduler::addSession(std::uint64_t seed) {
+    if (batches.empty() || batches.back().size == config.batchSize) {
+        Batch batch;
+        batch.sessions.reset(new Session[config.batchSize]);
+        batches.push_back(std::move(batch));
+    }
+    Batch& batch = batches.back();
+    Session& s = batch.sessions[batch.size++];
+    ++batch.unfinished;
+
+    s.rng = CounterRng::forBattle(seed, count);
+    s.game.setRng(&s.rng);
+    s.game.setOutput(&quiet);
+    return count++;
+}
+
+SessionScheduler::Session& SessionScheduler::session(std::size_t id) {
+    return batches[id / config.batchSize].sessions[id % config.batchSize];
+}
+
+const SessionScheduler::Session& SessionScheduler::session(std::size_t id) const {
+    return batches[id / config.batchSize].sessions[id % config.batchSize];
+}
+
+// Eén slice: elke onafgemaakte sessie van de batch turnsPerSlice beurten verder.
+void SessionScheduler::stepBatch(Batch& batch, Worker& me) const {
+    ++me.slices;
+    const std::uint32_t turnsPerSlice = config.turnsPerSlice;
+    for (std::size_t i = 0; i < batch.size; ++i) {
+        Session& s = batch.sessions[i];
+        if (s.game.status().finished()) continue;
+
+        const std::uint64_t begin = Instrumentation::now();
+        if (s.metrics.slices == 0) s.metrics.firstNs = begin;
+        else {
+            const std::uint64_t gap = begin - s.metrics.lastSliceNs;
+            s.metrics.maxGapNs = std::max(s.metrics.maxGapNs, gap);
+            me.sliceGap.add(gap);
+        }
+
+        GameStatus status;
+        for (std::uint32_t t = 0; t < turnsPerSlice; ++t) {
+            status = s.game.stepTurn();
+            if (status.finished()) break;
+        }
+        const std::uint64_t end = Instrumentation::now();
+
+        me.turns += status.turns - s.metrics.turns;
+        s.metrics.turns = status.turns;
+        ++s.metrics.slices;
+        s.metrics.busyNs += end - begin;
+        s.metrics.lastSliceNs = end;
+        if (status.finished()) {
+            s.metrics.finishedNs = end;
+            s.metrics.won = status.playerAlive;
+            s.metrics.hpRemaining = s.game.getRoster()[0].getHealth();
+            me.completion.add(end - s.metrics.firstNs);
+            --batch.unfinished;
+        }
+    }
+}
+
+SchedulerReport SessionScheduler::run() {
+    unsigned threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    std::vector<Batch*> pending;
+    for (Batch& b : batches)
+        if (b.unfinished) pending.push_back(&b);
+    threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, pending.size())));
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned w = 0; w < threads; ++w) workers.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < pending.size(); ++i) workers[i % threads]->push(pending[i]);
+
+    std::atomic<std::size_t> remaining{pending.size()};
+    std::atomic<std::size_t> queued{pending.size()};   // batches in een rij
+    std::atomic<unsigned> sleeping{0};
+
+    // Workers zonder werk slapen op idle; wakker bij een batch die te stelen
+    // is of als alles klaar is. sleeping wordt onder idleMutex opgehoogd
+    // voor de check, dus een notify na een verhoging van queued gaat niet
+    // verloren.
+    std::mutex idleMutex;
+    std::condition_variable idle;
+    auto wakeIdle = [&](bool all) {
+        if (sleeping.load() == 0) return;
+        { std::lock_guard<std::mutex> lock(idleMutex); }
+        if (all) idle.notify_all();
+        else idle.notify_one();
+    };
+
+    auto work = [&](unsigned self) {
+        Worker& me = *workers[self];
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            Batch* batch = me.popFront();
+            for (unsigned k = 1; !batch && k < threads; ++k) {
+                batch = workers[(self + k) % threads]->stealBack();
+                if (batch) ++me.steals;
+            }
+            if (!batch) {
+                std::unique_lock<std::mutex> lock(idleMutex);
+                ++sleeping;
+                idle.wait(lock, [&] { return queued.load() > 0 || remaining.load() == 0; });
+                --sleeping;
+                continue;
+            }
+            queued.fetch_sub(1);
+
+            stepBatch(*batch, me);
+            if (batch->unfinished) {
+                queued.fetch_add(1);
+                // Alleen wekken als er meer ligt dan de eigenaar zelf direct pakt.
+                if (me.push(batch) > 1) wakeIdle(false);
+            } else if (remaining.fetch_sub(1) == 1) {
+                wakeIdle(true);
+            }
+        }
+    };
+
+    const std::uint64_t start = Instrumentation::now();
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < threads; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (auto& t : pool) t.join();
+
+    SchedulerReport report;
+    report.seconds = static_cast<double>(Instrumentation::now() - start) / 1e9;
+    report.sessions = count;
+    for (auto& w : workers) {
+        report.turns += w->turns;
+        report.slices += w->slices;
+        report.steals += w->steals;
+        report.sliceGap.merge(w->sliceGap);
+        report.completion.merge(w->completion);
+        report.turnsPerWorker.push_back(w->turns);
+    }
+    return report;
+}
+
+} // namespace rpg
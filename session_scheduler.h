@@ -0,0 +1,101 @@
+#pragma once
+#include "instrumentation.h"
+#include "rpg_classes.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace rpg {
+
+// ----------------------------
+// Scheduler configuratie
+// ----------------------------
+struct SchedulerConfig {
+    unsigned threads = 0;              // 0 = hardware_concurrency()
+    std::size_t batchSize = 64;        // sessies per taak, aaneengesloten in geheugen
+    std::uint32_t turnsPerSlice = 1;   // beurten per sessie voordat de batch terug in de rij gaat
+};
+
+// ----------------------------
+// Metrics
+// ----------------------------
+struct SessionMetrics {
+    std::uint32_t turns = 0;
+    std::uint32_t slices = 0;
+    std::uint64_t busyNs = 0;        // tijd in stepTurn()
+    std::uint64_t firstNs = 0;       // steady_clock tijd van de eerste slice
+    std::uint64_t finishedNs = 0;
+    std::uint64_t maxGapNs = 0;      // langste wachttijd tussen twee slices
+    std::uint64_t lastSliceNs = 0;
+    bool won = false;
+    int hpRemaining = 0;
+};
+
+struct SchedulerReport {
+    std::uint64_t sessions = 0;
+    std::uint64_t turns = 0;
+    std::uint64_t slices = 0;        // batch slices
+    std::uint64_t steals = 0;
+    double seconds = 0.0;
+    PhaseStats sliceGap;             // wachttijd tussen slices van dezelfde sessie
+    PhaseStats completion;           // eerste slice tot finish, per sessie
+    std::vector<std::uint64_t> turnsPerWorker;
+
+    double turnsPerSecond() const;
+    double sessionsPerSecond() const;
+};
+
+void printSchedulerReport(std::ostream& os, const SchedulerReport& report);
+
+// ----------------------------
+// SessionScheduler
+// ----------------------------
+// Verdeelt veel onafhankelijke games over een vaste pool threads. Sessies
+// zitten in batches van batchSize; een worker stapt elke sessie van een
+// batch turnsPerSlice beurten verder en zet de batch achteraan zijn eigen
+// rij (round robin, dus eerlijk per sessie). Een worker zonder werk steelt
+// een batch van de achterkant van een andere rij en slaapt als er niets te
+// stelen is, tot er een batch over is of alles klaar is. Sessie id gebruikt
+// CounterRng::forBattle(seed, id): het resultaat hangt niet af van het
+// aantal threads of de volgorde van de slices.
+class SessionScheduler {
+public:
+    struct Session {
+        Game game;
+        CounterRng rng{0};
+        SessionMetrics metrics;
+    };
+
+    explicit SessionScheduler(const SchedulerConfig& config = SchedulerConfig());
+    SessionScheduler(const SessionScheduler&) = delete;
+    SessionScheduler& operator=(const SessionScheduler&) = delete;
+
+    // Nieuwe sessie zonder console output; geeft het sessie id terug.
+    std::size_t addSession(std::uint64_t seed);
+    inline std::size_t size() const { return count; }
+
+    // Speelt alle sessies uit en blokkeert tot ze klaar zijn.
+    SchedulerReport run();
+
+    Session& session(std::size_t id);
+    const Session& session(std::size_t id) const;
+
+private:
+    struct Batch {
+        std::unique_ptr<Session[]> sessions;
+        std::size_t size = 0;
+        std::size_t unfinished = 0;
+    };
+    class Worker;
+
+    void stepBatch(Batch& batch, Worker& me) const;
+
+    SchedulerConfig config;
+    NullSink quiet;
+    std::vector<Batch> batches;
+    std::size_t count = 0;
+};
+
+} // namespace rpg